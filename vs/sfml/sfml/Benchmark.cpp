@@ -0,0 +1,466 @@
+#include "Benchmark.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <assert.h>
+
+#include "Board.h"
+#include "MeepleBag.h"
+#include "Meeple.h"
+#include "GameState.h"
+#include "WinKernel.h"
+#include "Position.h"
+#include "MoveGenerator.h"
+#include "SolverAI.h"
+#include "MctsAI.h"
+#include "SmartAI.h"
+
+
+
+//Measures the time of a function call in seconds
+template<typename Function>
+static double measureSeconds(Function function){
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    function();
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+
+//A board of a game, which has been played randomly (each board has its own bags, since the board only references the meeples)
+struct RandomGame{
+    MeepleBag white;
+    MeepleBag black;
+    Board board;
+
+    explicit RandomGame(unsigned int meepleCount) : white(MeepleColor::WHITE), black(MeepleColor::BLACK){
+        GameState gameState(&white, &black, &board);
+        for (unsigned int m = 0; m < meepleCount; ++m){
+            MeepleBag& bag = (m % 2 == 0) ? white : black;
+            gameState.play(board.getRandomEmptyField(), *bag.getMeeple(rand() % bag.getMeepleCount()));
+        }
+    }
+};
+
+
+//Plays random moves (without giving away immediate wins) from the beginning of the game, until emptyFields fields are left; the game must not be decided yet
+//Returns false, if the game ended before
+static bool playRandomPosition(unsigned int emptyFields, Position& position){
+    position = Position::empty();
+    while (static_cast<unsigned int>(FIELD_COUNT - popcount16(position.occupied)) > emptyFields || position.meepleToSet == NO_MEEPLE){
+        MoveList moves;
+        generateMoves(position, moves, MoveFilter::NO_LOSING_GIVES);
+        const CompoundMove& move = moves.moves[rand() % moves.count];
+        if (move.give == NO_MEEPLE){
+            return false;
+        }
+        position = playMove(position, move);
+        if (position.checkWinSituation() || getWinningCodes(position) & (1 << position.meepleToSet)){
+            return false;
+        }
+    }
+    return true;
+}
+
+//A fixed set of positions for search benchmarks (the same positions in every run)
+static std::vector<Position> buildPositionSuite(unsigned int count, unsigned int emptyFields){
+    srand(42);
+    std::vector<Position> positions;
+    Position position;
+    while (positions.size() < count){
+        if (playRandomPosition(emptyFields, position)){
+            positions.push_back(position);
+        }
+    }
+    return positions;
+}
+
+
+//The pointer based check of the former Board::checkSimpleWinCombination(): compares the properties of the meeples of each win combination
+static uint16_t checkWinLinesWithPointers(const Board& board){
+    const WinCombinationSet* combinations = board.getWinCombinations();
+    uint16_t won = 0;
+    for (uint8_t line = 0; line < WIN_LINE_COUNT; ++line){
+        const WinCombination& comb = combinations->combination[line];
+        if (comb.meeples[0] == nullptr || comb.meeples[1] == nullptr || comb.meeples[2] == nullptr || comb.meeples[3] == nullptr){
+            continue;
+        }
+        for (unsigned int p = 0; p < PROPERTY_COUNT; ++p){
+            MeepleProperty prop = comb.meeples[0]->getProperty(p);
+            if (comb.meeples[1]->getProperty(p) == prop && comb.meeples[2]->getProperty(p) == prop && comb.meeples[3]->getProperty(p) == prop){
+                won |= static_cast<uint16_t>(1 << line);
+                break;
+            }
+        }
+    }
+    return won;
+}
+
+
+//Compares the batch kernels with the pointer based check and the incremental check of the board
+static void benchmarkWinDetection(){
+    const unsigned int BOARD_COUNT = 4096;
+    const unsigned int REPETITIONS = 200;
+
+    std::cout << "Generating " << BOARD_COUNT << " random boards..." << std::endl;
+    std::vector<RandomGame*> games;
+    std::vector<PackedBoard> packed;
+    games.reserve(BOARD_COUNT);
+    packed.reserve(BOARD_COUNT);
+    for (unsigned int b = 0; b < BOARD_COUNT; ++b){
+        games.push_back(new RandomGame(rand() % (FIELD_COUNT + 1)));
+        packed.push_back(PackedBoard::fromBoard(games.back()->board));
+    }
+
+    //correctness:
+    std::vector<uint16_t> reference(BOARD_COUNT);
+    std::vector<uint16_t> result(BOARD_COUNT);
+    unsigned int wonBoards = 0;
+    for (unsigned int b = 0; b < BOARD_COUNT; ++b){
+        reference[b] = checkWinLinesWithPointers(games[b]->board);
+        wonBoards += (reference[b] != 0) ? 1 : 0;
+        if (games[b]->board.getWonLines() != reference[b]){
+            std::cout << "ERROR: Board::getWonLines() differs from the pointer based check at board " << b << std::endl;
+        }
+    }
+    std::cout << wonBoards << " of the boards contain a win" << std::endl;
+    const WinKernel::Enum kernels[3] = { WinKernel::SCALAR, WinKernel::SSE2, WinKernel::AVX2 };
+    for (unsigned int k = 0; k < 3; ++k){
+        if (!WinKernel::isSupported(kernels[k])){
+            continue;
+        }
+        checkWinLines(&packed[0], &result[0], BOARD_COUNT, kernels[k]);
+        if (result != reference){
+            std::cout << "ERROR: the " << WinKernel::toString(kernels[k]) << " kernel differs from the pointer based check" << std::endl;
+        }
+    }
+
+    //throughput:
+    const double checks = static_cast<double>(BOARD_COUNT) * REPETITIONS;
+    unsigned int checksum = 0;      //prevents the compiler from removing the loops
+    std::cout << std::fixed << std::setprecision(1);
+
+    double seconds = measureSeconds([&](){
+        for (unsigned int r = 0; r < REPETITIONS; ++r){
+            for (unsigned int b = 0; b < BOARD_COUNT; ++b){
+                checksum += checkWinLinesWithPointers(games[b]->board);
+            }
+        }
+    });
+    const double pointerRate = checks / seconds;
+    std::cout << std::setw(28) << std::left << "pointer based check:" << std::setw(8) << std::right << pointerRate / 1e6 << " M boards/s" << std::endl;
+
+    seconds = measureSeconds([&](){
+        for (unsigned int r = 0; r < REPETITIONS; ++r){
+            for (unsigned int b = 0; b < BOARD_COUNT; ++b){
+                checksum += games[b]->board.checkWinSituation() != nullptr ? 1 : 0;
+            }
+        }
+    });
+    std::cout << std::setw(28) << std::left << "Board::checkWinSituation():" << std::setw(8) << std::right << checks / seconds / 1e6 << " M boards/s (incremental - only reads the result)" << std::endl;
+
+    for (unsigned int k = 0; k < 3; ++k){
+        if (!WinKernel::isSupported(kernels[k])){
+            std::cout << std::setw(28) << std::left << (std::string(WinKernel::toString(kernels[k])) + " kernel:") << "not supported by this CPU" << std::endl;
+            continue;
+        }
+        seconds = measureSeconds([&](){
+            for (unsigned int r = 0; r < REPETITIONS; ++r){
+                checkWinLines(&packed[0], &result[0], BOARD_COUNT, kernels[k]);
+                checksum += result[r % BOARD_COUNT];
+            }
+        });
+        std::cout << std::setw(28) << std::left << (std::string(WinKernel::toString(kernels[k])) + " kernel:") << std::setw(8) << std::right << checks / seconds / 1e6 << " M boards/s (x" << std::setprecision(1) << checks / seconds / pointerRate << ")" << std::endl;
+    }
+    std::cout << "Best kernel for this CPU: " << WinKernel::toString(WinKernel::getBest()) << " (checksum " << checksum << ")" << std::endl;
+
+    for (std::vector<RandomGame*>::iterator it = games.begin(); it != games.end(); ++it){
+        delete *it;
+    }
+}
+
+
+//Checks the line tables of the SmartAI against the original calculation with every possible input
+static void benchmarkSmartTables(){
+    SmartAI ai;
+    unsigned int mismatches = 0;
+    double seconds = measureSeconds([&](){
+        mismatches = ai.checkLineTables(std::cout);
+    });
+    std::cout << std::fixed << std::setprecision(1) << "checked in " << seconds << " s" << std::endl;
+    if (mismatches > 0){
+        std::cout << "ERROR: the SmartAI's line tables are wrong" << std::endl;
+    }
+}
+
+//Solves the same positions with different sizes of the transposition table of the SolverAI
+static void benchmarkTranspositionTable(){
+    const unsigned int POSITION_COUNT = 50;
+    const unsigned int EMPTY_FIELDS = SOLVER_EXACT_EMPTY_FIELDS;
+    const unsigned int TABLE_SIZES[] = { 1, 4, 16, 64, 256 };      //MB
+
+    std::vector<Position> positions = buildPositionSuite(POSITION_COUNT, EMPTY_FIELDS);
+    std::cout << POSITION_COUNT << " positions with " << EMPTY_FIELDS << " empty fields" << std::endl;
+
+    for (unsigned int t = 0; t < sizeof(TABLE_SIZES) / sizeof(TABLE_SIZES[0]); ++t){
+        SolverAI* solver = new SolverAI(SearchLimits(), 1, TABLE_SIZES[t]);
+        unsigned long long nodes = 0;
+        double seconds = measureSeconds([&](){
+            for (unsigned int p = 0; p < POSITION_COUNT; ++p){
+                solver->searchBestMove(positions[p]);
+                nodes += solver->getNodeCount();
+            }
+        });
+        std::cout << std::endl << "Table size " << TABLE_SIZES[t] << " MB: " << std::fixed << std::setprecision(3) << seconds << " s, " << nodes << " nodes, " << std::setprecision(0) << nodes / seconds << " nodes/s" << std::endl;
+        solver->getTranspositionTable().printStatistics(std::cout);
+        delete solver;
+    }
+}
+
+
+//Solves the same positions with 1, 2, 4, 8 and 16 threads (Lazy SMP), and prints the speedup compared to 1 thread
+static void benchmarkSmp(){
+    const unsigned int POSITION_COUNT = 30;
+    const unsigned int EMPTY_FIELDS = SOLVER_EXACT_EMPTY_FIELDS;
+    const unsigned int THREAD_COUNTS[] = { 1, 2, 4, 8, 16 };
+
+    std::vector<Position> positions = buildPositionSuite(POSITION_COUNT, EMPTY_FIELDS);
+    std::cout << POSITION_COUNT << " positions with " << EMPTY_FIELDS << " empty fields (solved exactly), " << std::thread::hardware_concurrency() << " cores" << std::endl;
+
+    double singleThreadSeconds = 0;
+    for (unsigned int t = 0; t < sizeof(THREAD_COUNTS) / sizeof(THREAD_COUNTS[0]); ++t){
+        SolverAI* solver = new SolverAI(SearchLimits(), THREAD_COUNTS[t]);
+        unsigned long long nodes = 0;
+        double seconds = measureSeconds([&](){
+            for (unsigned int p = 0; p < POSITION_COUNT; ++p){
+                solver->searchBestMove(positions[p]);
+                nodes += solver->getNodeCount();
+            }
+        });
+        if (t == 0){
+            singleThreadSeconds = seconds;
+        }
+        std::cout << std::setw(3) << std::right << THREAD_COUNTS[t] << " threads: " << std::fixed << std::setprecision(3) << std::setw(8) << seconds << " s, "
+            << std::setw(12) << nodes << " nodes, " << std::setprecision(0) << std::setw(10) << nodes / seconds << " nodes/s, speedup x" << std::setprecision(2) << singleThreadSeconds / seconds << std::endl;
+        delete solver;
+    }
+}
+
+
+//Searches the same positions with and without the killer and history heuristics of the SolverAI (nodes and time)
+static void benchmarkMoveOrdering(){
+    const unsigned int POSITION_COUNT = 30;
+    const unsigned int EMPTY_FIELDS[] = { SOLVER_EXACT_EMPTY_FIELDS, 12 };
+    const unsigned int DEPTHS[] = { 0, 6 };         //0: the default limits (solved exactly)
+
+    for (unsigned int s = 0; s < sizeof(EMPTY_FIELDS) / sizeof(EMPTY_FIELDS[0]); ++s){
+        std::vector<Position> positions = buildPositionSuite(POSITION_COUNT, EMPTY_FIELDS[s]);
+        std::cout << POSITION_COUNT << " positions with " << EMPTY_FIELDS[s] << " empty fields, " << (DEPTHS[s] > 0 ? "depth " : "solved exactly");
+        if (DEPTHS[s] > 0){
+            std::cout << DEPTHS[s];
+        }
+        std::cout << std::endl;
+
+        unsigned long long nodesWithout = 0;
+        for (unsigned int ordering = 0; ordering < 2; ++ordering){
+            SolverAI* solver = new SolverAI(SearchLimits(DEPTHS[s]));
+            solver->setMoveOrdering(ordering == 1);
+            unsigned long long nodes = 0;
+            double seconds = measureSeconds([&](){
+                for (unsigned int p = 0; p < POSITION_COUNT; ++p){
+                    solver->searchBestMove(positions[p]);
+                    nodes += solver->getNodeCount();
+                }
+            });
+            if (ordering == 0){
+                nodesWithout = nodes;
+            }
+            std::cout << (ordering == 1 ? "  killers + history: " : "  table move only:   ") << std::fixed << std::setprecision(3) << std::setw(8) << seconds << " s, "
+                << std::setw(12) << nodes << " nodes (" << std::setprecision(1) << 100.0 * nodes / nodesWithout << "%)" << std::endl;
+            delete solver;
+        }
+    }
+}
+
+
+//Measures the random playouts alone, and the whole search of the MctsAI (tree + playouts)
+static void benchmarkPlayouts(){
+    const unsigned int PLAYOUT_COUNT = 2000000;
+    const unsigned int EMPTY_FIELDS[] = { 16, 12, 8 };
+    const unsigned int SEARCH_PLAYOUTS = 200000;
+
+    std::cout << std::fixed;
+    for (unsigned int e = 0; e < sizeof(EMPTY_FIELDS) / sizeof(EMPTY_FIELDS[0]); ++e){
+        std::vector<Position> positions = buildPositionSuite(64, EMPTY_FIELDS[e]);
+        PlayoutRandom random(42);
+        unsigned int results[3] = { 0, 0, 0 };
+        double seconds = measureSeconds([&](){
+            for (unsigned int p = 0; p < PLAYOUT_COUNT; ++p){
+                ++results[playRandomGame(positions[p % positions.size()], random)];
+            }
+        });
+        std::cout << "playouts from " << std::setw(2) << EMPTY_FIELDS[e] << " empty fields: " << std::setprecision(2) << std::setw(6) << PLAYOUT_COUNT / seconds / 1e6 << " M playouts/s"
+            << " (white " << results[MeepleColor::WHITE] << ", black " << results[MeepleColor::BLACK] << ", ties " << results[MCTS_TIE] << ")" << std::endl;
+    }
+
+    MctsAI mcts(SearchLimits(0, 0, SEARCH_PLAYOUTS));
+    Position position = Position::empty();
+    double seconds = measureSeconds([&](){
+        mcts.searchBestMove(position);
+    });
+    std::cout << "MctsAI search from the beginning: " << std::setprecision(2) << mcts.getPlayoutCount() / seconds / 1e6 << " M playouts/s, " << mcts.getNodeCount() << " nodes" << std::endl;
+}
+
+
+//Runs the MctsAI for a fixed time with 1, 2, 4, 8 and 16 threads (playouts/s), and measures the reuse of the tree in a game against itself
+static void benchmarkMcts(){
+    const float MOVE_TIME = 0.5f;
+    const unsigned int EMPTY_FIELDS[] = { 16, 12, 8 };
+    const unsigned int THREAD_COUNTS[] = { 1, 2, 4, 8, 16 };
+    const unsigned int GAME_PLAYOUTS = 50000;
+
+    std::cout << MOVE_TIME << " s per position from " << EMPTY_FIELDS[0] << ", " << EMPTY_FIELDS[1] << " and " << EMPTY_FIELDS[2] << " empty fields, "
+        << std::thread::hardware_concurrency() << " cores" << std::endl;
+    std::vector<Position> positions;
+    for (unsigned int e = 0; e < sizeof(EMPTY_FIELDS) / sizeof(EMPTY_FIELDS[0]); ++e){
+        positions.push_back(buildPositionSuite(1, EMPTY_FIELDS[e])[0]);
+    }
+
+    double singleThreadRate = 0;
+    for (unsigned int t = 0; t < sizeof(THREAD_COUNTS) / sizeof(THREAD_COUNTS[0]); ++t){
+        unsigned long long playouts = 0;
+        double seconds = 0;
+        for (unsigned int p = 0; p < positions.size(); ++p){
+            MctsAI* mcts = new MctsAI(SearchLimits(0, MOVE_TIME), THREAD_COUNTS[t]);        //A new AI for each position: no reused tree
+            seconds += measureSeconds([&](){
+                mcts->searchBestMove(positions[p]);
+            });
+            playouts += mcts->getPlayoutCount();
+            delete mcts;
+        }
+        const double rate = playouts / seconds;
+        if (t == 0){
+            singleThreadRate = rate;
+        }
+        std::cout << std::setw(3) << std::right << THREAD_COUNTS[t] << " threads: " << std::fixed << std::setprecision(2) << std::setw(6) << rate / 1e6 << " M playouts/s, speedup x" << rate / singleThreadRate << std::endl;
+    }
+
+    //Subtree reuse: the AI plays both sides, so the tree of each decision is reused by the decision after the next turn
+    MctsAI mcts(SearchLimits(0, 0, GAME_PLAYOUTS));
+    Position position = Position::empty();
+    std::cout << "Reused nodes in a game (" << GAME_PLAYOUTS << " playouts per turn):";
+    while (!position.isFull() && !position.checkWinSituation()){
+        CompoundMove move = mcts.searchBestMove(position);
+        std::cout << " " << mcts.getReusedNodeCount();
+        position = playMove(position, move);
+    }
+    std::cout << std::endl;
+}
+
+
+//Lets the AI ponder on the opponent's position for the given time, and returns the time of its decision in the position after the opponent's move
+template<typename AI>
+static double decideAfterPondering(AI& ai, const Position& opponentPosition, const Position& position, unsigned int ponderMilliseconds){
+    std::atomic<bool> stop(false);
+    std::thread ponderThread([&](){ ai.ponder(opponentPosition, stop); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(ponderMilliseconds));
+    stop.store(true);
+    ponderThread.join();
+    return measureSeconds([&](){ ai.searchBestMove(position); });
+}
+
+//Measures the decisions of the SolverAI and the MctsAI after the opponent's turn, with and without pondering during the turn
+static void benchmarkPonder(){
+    const unsigned int POSITION_COUNT = 10;
+    const unsigned int EMPTY_FIELDS = SOLVER_EXACT_EMPTY_FIELDS + 1;        //The AI's position is solved exactly
+    const unsigned int PONDER_MILLISECONDS = 1000;
+    const float MOVE_TIME = 0.5f;
+
+    //The opponent's positions, and the AI's positions after a likely move of the opponent (found by a short search):
+    const std::vector<Position> candidates = buildPositionSuite(4 * POSITION_COUNT, EMPTY_FIELDS);
+    std::vector<Position> opponentPositions;
+    std::vector<Position> positions;
+    MctsAI opponent(SearchLimits(0, 0, MCTS_DEFAULT_PLAYOUTS));
+    for (unsigned int c = 0; c < candidates.size() && positions.size() < POSITION_COUNT; ++c){
+        const CompoundMove move = opponent.searchBestMove(candidates[c]);
+        const Position position = playMove(candidates[c], move);
+        if (move.give != NO_MEEPLE && !position.checkWinSituation() && (getWinningCodes(position) & (1 << position.meepleToSet)) == 0){    //The AI has a decision to make
+            opponentPositions.push_back(candidates[c]);
+            positions.push_back(position);
+        }
+    }
+    assert(positions.size() == POSITION_COUNT);
+    std::cout << POSITION_COUNT << " positions with " << EMPTY_FIELDS << " empty fields, " << PONDER_MILLISECONDS << " ms pondering per opponent's turn" << std::endl;
+
+    double coldSeconds = 0;
+    double ponderSeconds = 0;
+    for (unsigned int p = 0; p < POSITION_COUNT; ++p){
+        SolverAI* cold = new SolverAI();
+        coldSeconds += measureSeconds([&](){ cold->searchBestMove(positions[p]); });
+        delete cold;
+        SolverAI* pondering = new SolverAI();
+        ponderSeconds += decideAfterPondering(*pondering, opponentPositions[p], positions[p], PONDER_MILLISECONDS);
+        delete pondering;
+    }
+    std::cout << "SolverAI: " << std::fixed << std::setprecision(3) << coldSeconds / POSITION_COUNT << " s per decision without pondering, "
+        << ponderSeconds / POSITION_COUNT << " s after pondering" << std::endl;
+
+    //The MctsAI needs a timed decision before (the pondered decision ends, when the root has as many playouts as the last timed decision):
+    coldSeconds = 0;
+    ponderSeconds = 0;
+    unsigned int reusedNodes = 0;
+    for (unsigned int p = 0; p < POSITION_COUNT; ++p){
+        const Position& otherPosition = positions[(p + 1) % POSITION_COUNT];
+        MctsAI* cold = new MctsAI(SearchLimits(0, MOVE_TIME));
+        cold->searchBestMove(otherPosition);
+        coldSeconds += measureSeconds([&](){ cold->searchBestMove(positions[p]); });
+        delete cold;
+        MctsAI* pondering = new MctsAI(SearchLimits(0, MOVE_TIME));
+        pondering->searchBestMove(otherPosition);
+        ponderSeconds += decideAfterPondering(*pondering, opponentPositions[p], positions[p], PONDER_MILLISECONDS);
+        reusedNodes += pondering->getReusedNodeCount();
+        delete pondering;
+    }
+    std::cout << "MctsAI (" << MOVE_TIME << " s per decision): " << coldSeconds / POSITION_COUNT << " s per decision without pondering, "
+        << ponderSeconds / POSITION_COUNT << " s after pondering (" << reusedNodes / POSITION_COUNT << " reused nodes)" << std::endl;
+}
+
+
+
+struct BenchmarkSuite{
+    const char* name;
+    const char* description;
+    void(*run)();
+};
+
+static const BenchmarkSuite BENCHMARK_SUITES[] = {
+    { "win", "batch win detection (scalar/SSE2/AVX2) vs. the pointer based check", benchmarkWinDetection },
+    { "smarttables", "exhaustive check of the SmartAI's line tables against the original calculation", benchmarkSmartTables },
+    { "tt", "solver search with different transposition table sizes", benchmarkTranspositionTable },
+    { "smp", "solver search with 1 to 16 threads (Lazy SMP speedup)", benchmarkSmp },
+    { "order", "solver search with and without the killer and history move ordering", benchmarkMoveOrdering },
+    { "playout", "random playouts and Monte Carlo tree search", benchmarkPlayouts },
+    { "mcts", "Monte Carlo tree search with 1 to 16 threads, and the reuse of the tree", benchmarkMcts },
+    { "ponder", "decisions of the solver and the MCTS with and without pondering during the opponent's turn", benchmarkPonder }
+};
+
+
+bool runBenchmark(const std::string& suite){
+    for (unsigned int s = 0; s < sizeof(BENCHMARK_SUITES) / sizeof(BENCHMARK_SUITES[0]); ++s){
+        if (suite == BENCHMARK_SUITES[s].name){
+            std::cout << "Benchmark: " << BENCHMARK_SUITES[s].description << std::endl;
+            BENCHMARK_SUITES[s].run();
+            return true;
+        }
+    }
+    return false;
+}
+
+void printBenchmarkSuites(std::ostream& output){
+    for (unsigned int s = 0; s < sizeof(BENCHMARK_SUITES) / sizeof(BENCHMARK_SUITES[0]); ++s){
+        output << "                                              " << std::setw(10) << std::left << BENCHMARK_SUITES[s].name << BENCHMARK_SUITES[s].description << std::endl;
+    }
+}
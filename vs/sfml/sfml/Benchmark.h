@@ -0,0 +1,8 @@
+#pragma once
+#include <string>
+#include <ostream>
+
+
+//Performance measurements, started with the program parameter -bench=suite
+bool runBenchmark(const std::string& suite);        //Runs the benchmark suite and prints the results to the console; returns false, if there is no suite with this name
+void printBenchmarkSuites(std::ostream& output);    //Prints the names and descriptions of all suites
@@ -0,0 +1,23 @@
+#include "Bitboard.h"
+
+
+const uint16_t WIN_LINE_MASKS[WIN_LINE_COUNT] = {
+    0x000F, 0x00F0, 0x0F00, 0xF000,     //rows
+    0x1111, 0x2222, 0x4444, 0x8888,     //columns
+    0x8421,                             //diagonal top-left to bottom-right (fields 0, 5, 10, 15)
+    0x1248                              //diagonal top-right to bottom-left (fields 3, 6, 9, 12)
+};
+
+const uint16_t FIELD_LINES[FIELD_COUNT] = {
+    0x0111, 0x0021, 0x0041, 0x0281,     //row 0
+    0x0012, 0x0122, 0x0242, 0x0082,     //row 1
+    0x0014, 0x0224, 0x0144, 0x0084,     //row 2
+    0x0218, 0x0028, 0x0048, 0x0188      //row 3
+};
+
+const uint16_t MEEPLE_PROPERTY_MASKS[PROPERTY_PLANE_COUNT] = {
+    0x5555, 0xAAAA,                     //color (bit 0 of the code)
+    0x3333, 0xCCCC,                     //size (bit 1)
+    0x0F0F, 0xF0F0,                     //shape (bit 2)
+    0x00FF, 0xFF00                      //detail (bit 3)
+};
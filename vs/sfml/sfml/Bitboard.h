@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <assert.h>
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+
+//Helpers for the bitboard-representation of the board
+//A field is addressed by its index f = x + 4 * y (0 = top left, 3 = top right, 15 = bottom right)
+//A 16 bit mask stores one bit per field (bit f is set --> field f is part of the mask)
+
+
+#define FIELD_COUNT 16                                  //Number of fields on the board
+#define WIN_LINE_COUNT 10                               //4 rows, 4 columns, 2 diagonals
+#define PROPERTY_COUNT 4                                //color, size, shape, detail
+#define PROPERTY_PLANE_COUNT (2 * PROPERTY_COUNT)       //One plane for each value of each property
+
+
+//Masks of all combinations that can lead to a victory
+//Index: 0-3 = rows (top to bottom), 4-7 = columns (left to right), 8 = diagonal top-left to bottom-right, 9 = diagonal top-right to bottom-left
+//(VS2013 doesn't support constexpr - these are plain constant tables, defined in Bitboard.cpp)
+extern const uint16_t WIN_LINE_MASKS[WIN_LINE_COUNT];
+
+//Lines through each field: bit l is set, if WIN_LINE_MASKS[l] contains the field (2 lines for most fields, 3 for fields on a diagonal)
+extern const uint16_t FIELD_LINES[FIELD_COUNT];
+
+//Masks over the 16 meeple codes (see Meeple::getCode()): bit c is set, if the meeple with the code c has the property-value of the plane
+//Index: see getPropertyPlaneIndex()
+extern const uint16_t MEEPLE_PROPERTY_MASKS[PROPERTY_PLANE_COUNT];
+
+
+inline uint8_t getPropertyPlaneIndex(unsigned int propIdx, unsigned int value){     //Returns the plane, which stores the fields with the given property-value
+    assert(propIdx < PROPERTY_COUNT && value < 2);
+    return static_cast<uint8_t>(2 * propIdx + value);
+}
+
+
+inline uint8_t popcount16(uint16_t mask){               //Returns the number of set bits
+    mask = mask - ((mask >> 1) & 0x5555);
+    mask = (mask & 0x3333) + ((mask >> 2) & 0x3333);
+    mask = (mask + (mask >> 4)) & 0x0F0F;
+    return static_cast<uint8_t>((mask + (mask >> 8)) & 0x1F);
+}
+
+inline uint8_t lowestBitIndex(uint16_t mask){           //Returns the index of the lowest set bit; the mask must not be 0
+    assert(mask != 0);
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<uint8_t>(index);
+#else
+    return static_cast<uint8_t>(__builtin_ctz(mask));
+#endif
+}
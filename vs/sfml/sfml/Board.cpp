@@ -4,6 +4,7 @@
 #include <iostream>
 #include "Meeple.h"
 #include "MeepleBag.h"
+#include "Zobrist.h"
 
 std::string BoardPos::toString() const{
     return std::string('(' + std::to_string(x + 1) + '|' + std::to_string(y + 1) + ')');
@@ -21,183 +22,225 @@ WinCombination::WinCombination(const WinCombination& base){
 
 
 Board::Board(){
-    for (int y = 0; y < 4; ++y){
-        for (int x = 0; x < 4; ++x){
-            board[x][y] = nullptr;
-        }
-    }
-
-    //populate the winCombinations-positions:
-
-    //rows and columns:    
-        for (uint8_t rc = 0; rc < 4; ++rc){     //Row or column (depending)
-            WinCombination *row = new WinCombination();
-            WinCombination *col = new WinCombination();
-
-            for (uint8_t o = 0; o < 4; ++o){    //opposite axis
-                row->positions[o] = { o, rc };
-                col->positions[o] = { rc, o };
-                row->meeples[o] = nullptr;          //no meeples set yet
-                col->meeples[o] = nullptr;          //no meeples set yet
-                winCombinations.combination.insert(row);
-                winCombinations.combination.insert(col);
-            }
-        }
-    //diagonals:
-        WinCombination *diaTL = new WinCombination();   //diagonal top-left to bottom-right
-        WinCombination *diaTR = new WinCombination();   //diagonal top-right to bottom-left
-            
-        for (uint8_t d = 0; d < 4; ++d){
-            diaTL->positions[d] = { d, d };
-            diaTR->positions[d] = { 3 - d, d };
-            diaTL->meeples[d] = nullptr;          //no meeples set yet
-            diaTR->meeples[d] = nullptr;          //no meeples set yet
-            winCombinations.combination.insert(diaTL);
-            winCombinations.combination.insert(diaTR);
-        }
-    isWinCombinationSetUp2Date = true;
+    reset();
+    initWinCombinations();
 }
 
 
-Board::Board(const Board& base, const MeepleBag* bag1, const MeepleBag* bag2){
-    for (int y = 0; y < 4; ++y){
-        for (int x = 0; x < 4; ++x){
-            if (base.board[x][y] == nullptr){
-                board[x][y] = nullptr;
-                continue;
-            }
-            const MeepleBag* correctBag = (bag1->getBagColor() == base.board[x][y]->getColor()) ? bag1 : bag2;      //Only search in the correct bag
-            Meeple* correctMeeple = correctBag->getUsedMeepleRepresentation(*base.board[x][y]);
-            assert(correctMeeple != nullptr);
-            board[x][y] = correctMeeple;
+Board::Board(const Board& base, const MeepleBag* bag1, const MeepleBag* bag2) : occupied(base.occupied), wonLines(base.wonLines), hash(base.hash){
+    for (uint8_t f = 0; f < FIELD_COUNT; ++f){
+        codes[f] = base.codes[f];
+        if (base.meeples[f] == nullptr){
+            meeples[f] = nullptr;
+            continue;
         }
+        const MeepleBag* correctBag = (bag1->getBagColor() == base.meeples[f]->getColor()) ? bag1 : bag2;      //Only search in the correct bag
+        Meeple* correctMeeple = correctBag->getUsedMeepleRepresentation(*base.meeples[f]);
+        assert(correctMeeple != nullptr);
+        meeples[f] = correctMeeple;
     }
-    for (std::set<WinCombination*>::const_iterator it = base.winCombinations.combination.begin(); it != base.winCombinations.combination.end(); ++it){
-       winCombinations.combination.insert(new WinCombination(**it));     //Make a copy   (meeplepointers are nullptr --> upToDate = false)
+    for (uint8_t p = 0; p < PROPERTY_PLANE_COUNT; ++p){
+        planes[p] = base.planes[p];
     }
-    isWinCombinationSetUp2Date = false;
+    for (uint8_t line = 0; line < WIN_LINE_COUNT; ++line){
+        lineAnd[line] = base.lineAnd[line];
+        lineNor[line] = base.lineNor[line];
+        lineCount[line] = base.lineCount[line];
+    }
+    initWinCombinations();
 }
 
 
+Board::~Board(){
+}
 
 
-Board::~Board(){
-    for (std::set<WinCombination*>::iterator it = winCombinations.combination.begin(); it != winCombinations.combination.end(); ++it){
-        delete *it;
+void Board::initWinCombinations(){
+    //populate the winCombinations-positions (ascending field index within each line):
+    for (uint8_t line = 0; line < WIN_LINE_COUNT; ++line){
+        uint16_t mask = WIN_LINE_MASKS[line];
+        for (uint8_t m = 0; m < 4; ++m){
+            uint8_t field = lowestBitIndex(mask);
+            mask &= mask - 1;
+            winCombinations.combination[line].positions[m] = BoardPos::fromFieldIndex(field);
+            winCombinations.combination[line].meeples[m] = meeples[field];
+        }
     }
-    winCombinations.combination.clear();
 }
 
 
 void Board::reset(){
-    for (int y = 0; y < 4; ++y){
-        for (int x = 0; x < 4; ++x){
-            board[x][y] = nullptr;
+    for (uint8_t f = 0; f < FIELD_COUNT; ++f){
+        meeples[f] = nullptr;
+        codes[f] = 0;
+    }
+    occupied = 0;
+    for (uint8_t p = 0; p < PROPERTY_PLANE_COUNT; ++p){
+        planes[p] = 0;
+    }
+    for (uint8_t line = 0; line < WIN_LINE_COUNT; ++line){
+        lineAnd[line] = 0xF;
+        lineNor[line] = 0xF;
+        lineCount[line] = 0;
+        for (uint8_t m = 0; m < 4; ++m){
+            winCombinations.combination[line].meeples[m] = nullptr;
         }
     }
-    isWinCombinationSetUp2Date = false;
+    wonLines = 0;
+    hash = 0;
 }
 
 const WinCombinationSet* Board::getWinCombinations() const{
-    updateWinCombinations();
     return &winCombinations;
 }
 
-void Board::updateWinCombinations() const{
-    if (isWinCombinationSetUp2Date){
-        return;
+void Board::updateLine(uint8_t line){
+    uint8_t andCode = 0xF, norCode = 0xF, count = 0;
+    for (uint16_t fields = WIN_LINE_MASKS[line] & occupied; fields != 0; fields &= fields - 1){
+        uint8_t code = codes[lowestBitIndex(fields)];
+        andCode &= code;
+        norCode &= static_cast<uint8_t>(~code);
+        ++count;
     }
-    for (std::set<WinCombination*>::iterator it = winCombinations.combination.begin(); it != winCombinations.combination.end(); ++it){
-        for (int m = 0; m < 4; ++m){
-            (*it)->meeples[m] = board[(*it)->positions[m].x][(*it)->positions[m].y];
-        }
+    lineAnd[line] = andCode;
+    lineNor[line] = norCode;
+    lineCount[line] = count;
+    if (count == 4 && ((andCode | norCode) & 0xF) != 0){
+        wonLines |= static_cast<uint16_t>(1 << line);
+    }else{
+        wonLines &= static_cast<uint16_t>(~(1 << line));
     }
-    isWinCombinationSetUp2Date = true;
 }
 
 const Meeple* Board::getMeeple(BoardPos position) const{
     assert(position.x < 4 && position.y < 4);
-    return board[position.x][position.y];
+    return meeples[position.toFieldIndex()];
 }
 
 bool Board::isFieldEmpty(BoardPos position) const{
     assert(position.x < 4 && position.y < 4);
-    return board[position.x][position.y] == nullptr;
+    return (occupied & (1 << position.toFieldIndex())) == 0;
+}
+
+uint16_t Board::getOccupiedFields() const{
+    return occupied;
+}
+
+uint16_t Board::getPropertyPlane(uint8_t plane) const{
+    assert(plane < PROPERTY_PLANE_COUNT);
+    return planes[plane];
 }
 
 void Board::setMeeple(BoardPos position, Meeple& meeple){
     assert(position.x < 4 && position.y < 4);
     assert(isFieldEmpty(position));
-    board[position.x][position.y] = &meeple;
-    isWinCombinationSetUp2Date = false;
+    uint8_t field = position.toFieldIndex();
+    uint16_t bit = static_cast<uint16_t>(1 << field);
+    uint8_t code = meeple.getCode();
+
+    meeples[field] = &meeple;
+    codes[field] = code;
+    occupied |= bit;
+    hash ^= ZOBRIST.field[field][code];
+    for (uint8_t p = 0; p < PROPERTY_COUNT; ++p){
+        planes[getPropertyPlaneIndex(p, (code >> p) & 1)] |= bit;
+    }
+
+    //Only the lines through this field change:
+    for (uint16_t lines = FIELD_LINES[field]; lines != 0; lines &= lines - 1){
+        uint8_t line = lowestBitIndex(lines);
+        lineAnd[line] &= code;
+        lineNor[line] &= static_cast<uint8_t>(~code);
+        if (++lineCount[line] == 4 && ((lineAnd[line] | lineNor[line]) & 0xF) != 0){
+            wonLines |= static_cast<uint16_t>(1 << line);
+        }
+        winCombinations.combination[line].meeples[popcount16(WIN_LINE_MASKS[line] & (bit - 1))] = &meeple;     //position within the line = number of line-fields before this one
+    }
+    assert(wonLines == calculateWonLines());
+    assert(hash == calculateHash());
 }
 
 Meeple* Board::removeMeeple(BoardPos position){
-    Meeple* m = board[position.x][position.y];
-    board[position.x][position.y] = nullptr;
-    isWinCombinationSetUp2Date = false;
+    assert(position.x < 4 && position.y < 4);
+    uint8_t field = position.toFieldIndex();
+    uint16_t bit = static_cast<uint16_t>(1 << field);
+    uint16_t keep = static_cast<uint16_t>(~bit);
+
+    Meeple* m = meeples[field];
+    meeples[field] = nullptr;
+    hash ^= ZOBRIST.field[field][codes[field]];
+    occupied &= keep;
+    for (uint8_t p = 0; p < PROPERTY_PLANE_COUNT; ++p){
+        planes[p] &= keep;
+    }
+
+    for (uint16_t lines = FIELD_LINES[field]; lines != 0; lines &= lines - 1){
+        uint8_t line = lowestBitIndex(lines);
+        updateLine(line);       //An AND/NOR can't be undone - recalculate the line from the remaining (max. 3) fields
+        winCombinations.combination[line].meeples[popcount16(WIN_LINE_MASKS[line] & (bit - 1))] = nullptr;
+    }
+    assert(wonLines == calculateWonLines());
+    assert(hash == calculateHash());
     return m;
 }
 
 bool Board::isFull() const{
-    for (uint8_t y = 0; y < 4; ++y){
-        for (uint8_t x = 0; x < 4; ++x){
-            if (isFieldEmpty({ x, y })){
-                return false;
-            }
-        }
+    return occupied == 0xFFFF;
+}
+
+uint64_t Board::getHash() const{
+    return hash;
+}
+
+uint64_t Board::calculateHash() const{
+    uint64_t h = 0;
+    for (uint16_t fields = occupied; fields != 0; fields &= fields - 1){
+        uint8_t field = lowestBitIndex(fields);
+        h ^= ZOBRIST.field[field][codes[field]];
     }
-    return true;
+    return h;
 }
 
 BoardPos Board::getRandomEmptyField() const{
-    BoardPos pos;
-    do{
-        pos.x = rand() % 4;
-        pos.y = rand() % 4;
-    } while (!isFieldEmpty(pos));
-    return pos;
+    uint16_t empty = static_cast<uint16_t>(~occupied);
+    assert(empty != 0);
+    for (int skip = rand() % popcount16(empty); skip > 0; --skip){   //choose one of the empty fields
+        empty &= empty - 1;     //remove the lowest field
+    }
+    return BoardPos::fromFieldIndex(lowestBitIndex(empty));
 }
 
 
 
 
 
-const WinCombination* Board::checkWinSituation() const{
-    const WinCombinationSet* winCombinations = getWinCombinations();
+uint16_t Board::getWonLines() const{
+    return wonLines;
+}
 
-    for (std::set<WinCombination*>::iterator it = winCombinations->combination.begin(); it != winCombinations->combination.end(); ++it){
-        if (checkSimpleWinCombination(*it)){
-            return *it;
-        }
+const WinCombination* Board::checkWinSituation() const{
+    if (wonLines == 0){
+        return nullptr;
     }
-    return nullptr;
+    return &winCombinations.combination[lowestBitIndex(wonLines)];
 }
 
 
-bool Board::checkSimpleWinCombination(const WinCombination* comb) const{
-    //check null-pointers:
-        int m;
-        for (m = 0; m < 4; ++m){
-            if (comb->meeples[m] == nullptr){
-                return false;
-            }
+uint16_t Board::calculateWonLines() const{
+    uint16_t won = 0;
+    for (uint8_t line = 0; line < WIN_LINE_COUNT; ++line){
+        uint16_t lineMask = WIN_LINE_MASKS[line];
+        if ((occupied & lineMask) != lineMask){     //the line is not full
+            continue;
         }
-    //check similarity:
-        for (int p = 0; p < 4; ++p){
-            MeepleProperty prop = comb->meeples[0]->getProperty(p);
-            bool match = true;
-            for (m = 1; m < 4; ++m){
-                if (comb->meeples[m]->getProperty(p) != prop){
-                    match = false;
-                    break;
-                }
-            }
-            if (match){
-                return true;
+        for (uint8_t p = 0; p < PROPERTY_PLANE_COUNT; ++p){
+            if ((planes[p] & lineMask) == lineMask){    //all 4 meeples are in the same property plane
+                won |= static_cast<uint16_t>(1 << line);
+                break;
             }
         }
-    return false;
+    }
+    return won;
 }
 
 void Board::print(std::ostream& output) const{
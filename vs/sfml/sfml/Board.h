@@ -1,7 +1,8 @@
 #pragma once
 #include <cstdint>
 #include <string>
-#include <set>
+
+#include "Bitboard.h"
 
 class MeepleBag;
 class Meeple;
@@ -10,6 +11,14 @@ struct BoardPos{
     uint8_t x;
     uint8_t y;
     std::string toString() const;
+
+    uint8_t toFieldIndex() const{                   //Converts the 2D-coords into the bitboard field index [0-15]
+        return static_cast<uint8_t>(x + 4 * y);
+    }
+    static BoardPos fromFieldIndex(uint8_t field){  //Converts a bitboard field index [0-15] into 2D-coords
+        BoardPos pos = { static_cast<uint8_t>(field % 4), static_cast<uint8_t>(field / 4) };
+        return pos;
+    }
 	
 	bool isValid() const{
 		return x < 4 && y < 4;
@@ -27,20 +36,31 @@ struct WinCombination{      //Contains 4 meeples, that are either in a row, colu
     WinCombination(const WinCombination& base); //Creates a copy. (!) The meeple-pointers are set tu nullptr (!)
 };
 
-struct WinCombinationSet{   //Contains all possible combinations, that can lead to a victory
-    std::set<WinCombination*> combination;
+struct WinCombinationSet{   //Contains all possible combinations, that can lead to a victory (same order as WIN_LINE_MASKS)
+    WinCombination combination[WIN_LINE_COUNT];
 };
 
 
 class Board{
 private:
-    Meeple* board[4][4];   
+    Meeple* meeples[FIELD_COUNT];                               //The meeple-objects on the board (index = field index); only needed to hand out the meeples - all checks are done with the bitboards
+    uint8_t codes[FIELD_COUNT];                                 //The codes of the meeples on the board (see Meeple::getCode()); only valid for occupied fields
+    uint16_t occupied;                                          //Bitboard: all fields with a meeple
+    uint16_t planes[PROPERTY_PLANE_COUNT];                      //Bitboards: one plane per property value (see getPropertyPlaneIndex()), contains all fields with a meeple that has this value
+
+    //Running state of each line; updated for the 2-3 lines through a field, whenever a meeple is set or removed:
+        uint8_t lineAnd[WIN_LINE_COUNT];                        //AND of the codes of all meeples in the line (bit set: all meeples have the 2nd value of the property)
+        uint8_t lineNor[WIN_LINE_COUNT];                        //NOR of the codes of all meeples in the line (bit set: all meeples have the 1st value of the property)
+        uint8_t lineCount[WIN_LINE_COUNT];                      //Number of meeples in the line
+        uint16_t wonLines;                                      //bit l is set, if line l contains 4 similar meeples
+    uint64_t hash;                                              //Zobrist-hash of the meeples on the board (see ZOBRIST.field); updated by setMeeple/removeMeeple
 
-    mutable bool isWinCombinationSetUp2Date;                    //if false, the winCombinations-field needs to be updated before usage (can be changed by the const function "updateWinCombinations")
-    WinCombinationSet winCombinations;                          //Contains all possible win combinations (is buffered, to avoid new's and delete's all the time)
+    WinCombinationSet winCombinations;                          //Contains all possible win combinations (the meeple-pointers are kept up to date by setMeeple/removeMeeple)
     
-    bool checkSimpleWinCombination(const WinCombination* comb) const;  //Checks 4 meeples for similarity
-    void updateWinCombinations() const;                         //updates the winCombination-field (sets the meeple-pointers to the current board-state)
+    void updateLine(uint8_t line);                              //Recalculates the running state of a line from its fields
+    uint16_t calculateWonLines() const;                         //Checks all lines with the property planes (for assertions only)
+    uint64_t calculateHash() const;                             //Calculates the hash from scratch (for assertions only)
+    void initWinCombinations();                                 //Sets the positions of all winCombinations, and the meeple-pointers to the current board-state
     explicit Board(const Board& base);
 public:
     Board();
@@ -51,14 +71,18 @@ public:
 
     const Meeple* getMeeple(BoardPos position) const;
     bool isFieldEmpty(BoardPos position) const;
+    uint16_t getOccupiedFields() const;                         //Bitboard of all fields with a meeple
+    uint16_t getPropertyPlane(uint8_t plane) const;             //Bitboard of all fields with a meeple, that has the property value of the plane (see getPropertyPlaneIndex())
     void setMeeple(BoardPos position, Meeple& meeple);
     Meeple* removeMeeple(BoardPos position);                    //Removes a meeple from the board; DOES NOT DELETE the meeple
-    const WinCombinationSet* getWinCombinations() const;        //Returns all possible win-combinations. The result must not be deleted
+    const WinCombinationSet* getWinCombinations() const;        //Returns all possible win-combinations (always up to date). The result must not be deleted
     BoardPos getRandomEmptyField() const;                       //Returns an random empty field
 
     bool isFull() const;
+    uint64_t getHash() const;                                   //Zobrist-hash of the meeples on the board (doesn't contain the bags)
     
-    const WinCombination* checkWinSituation() const;            //Checks, if there are 4 similar meeples in a row/col/diagonal; if yes: return the meeples from the combination; otherwise, return nullptr
+    uint16_t getWonLines() const;                               //bit l is set, if the line WIN_LINE_MASKS[l] contains 4 similar meeples
+    const WinCombination* checkWinSituation() const;            //Checks, if there are 4 similar meeples in a row/col/diagonal; if yes: return the meeples from the combination; otherwise, return nullptr (constant time)
     
     void print(std::ostream& output) const;                     //For debugging purposes only
 };
@@ -326,6 +326,7 @@ GameMenuDecision::Enum Game::runGame(){
             firstFrameOfState = false;
         }
 	}
+    stopPondering();            //The game has been left during the human's turn
     backgroundMusic->stop();
     particleSystem->fadeOutAllParticles();
     return gameMenuDecision;
@@ -426,6 +427,21 @@ void Game::switchActivePlayer(){
 	}
 }
 
+void Game::startPondering(const Meeple* meepleToSet){
+	Player* opponent = players[(activePlayerIndex + 1) % 2];
+	if (opponent->type == Player::TC){
+		opponent->controller->run_ponder(*gameStates[activePlayerIndex], meepleToSet);
+	}
+}
+
+void Game::stopPondering(){
+	for (uint8_t p = 0; p < 2; ++p){
+		if (players[p]->type == Player::TC){
+			players[p]->controller->stopPondering();
+		}
+	}
+}
+
 
 
 
@@ -433,6 +449,7 @@ void Game::switchActivePlayer(){
 Game::LoopState Game::i_playerSelectMeeple(){
 	assert(players[activePlayerIndex]->type == Player::I_PLAYER);
 	todoText = RTextManager::GameAction::CHOOSE_A_MEEPLE;
+    aiThinkClock.restart();
     const Meeple* meeple = &players[activePlayerIndex]->player->selectOpponentsMeeple(*gameStates[activePlayerIndex]);
 
     selectedMeeple = players[(activePlayerIndex+1)%2]->rbag->getRmeepleFromUnused(meeple);
@@ -443,6 +460,9 @@ Game::LoopState Game::i_playerSelectMeeple(){
 Game::LoopState Game::humanSelectMeeple(InputEvents inputEvents){
     assert(players[activePlayerIndex]->type == Player::HUMAN);
 	todoText = RTextManager::GameAction::CHOOSE_A_MEEPLE;
+    if (firstFrameOfState){
+        startPondering(nullptr);
+    }
 
     if (inputEvents.releasedLeftMouse){
         selectedMeeple = players[(activePlayerIndex + 1) % 2]->rbag->getRMeepleAtPosition(inputEvents.mousePosition);
@@ -475,6 +495,7 @@ Game::LoopState Game::humanSelectMeeple(InputEvents inputEvents){
 Game::LoopState Game::tcStartSelectMeeple(){
 	todoText = RTextManager::GameAction::CHOOSE_A_MEEPLE;
 	assert(players[activePlayerIndex]->type == Player::TC);
+	aiThinkClock.restart();
 	players[activePlayerIndex]->controller->run_selectOpponentsMeeple(*gameStates[activePlayerIndex]);
 	return TC_WAIT_FOR_SELECTED_MEEPLE;
 }
@@ -495,7 +516,7 @@ Game::LoopState Game::highlightSelectedMeeple(float elapsedTime){
     assert(selectedMeeple != nullptr);
 
     if (firstFrameOfState){        
-        remainingThinkTime = players[activePlayerIndex]->meepleChoosingThinkTime.get();
+        remainingThinkTime = players[activePlayerIndex]->meepleChoosingThinkTime.get() - aiThinkClock.getElapsedTime().asSeconds();
     }
     if (remainingThinkTime > 0){                //Time, before the AI starts moving the meeple
         remainingThinkTime -= elapsedTime;
@@ -511,6 +532,7 @@ Game::LoopState Game::highlightSelectedMeeple(float elapsedTime){
 Game::LoopState Game::i_playerSelectMeeplePosition(){
 	assert(players[activePlayerIndex]->type == Player::I_PLAYER);
 	todoText = RTextManager::GameAction::SELECT_MEEPLE_POS;
+    aiThinkClock.restart();
     selectedBoardPos = players[activePlayerIndex]->player->selectMeeplePosition(*gameStates[activePlayerIndex], *(selectedMeeple->getLogicalMeeple()));
 	return MOVE_MEEPLE_TO_SELECTED_POSITION;
 }
@@ -519,6 +541,9 @@ Game::LoopState Game::humanSelectMeeplePosition(InputEvents inputEvents){
 	assert(players[activePlayerIndex]->type == Player::HUMAN);
 	assert(selectedMeeple != nullptr);
 	todoText = RTextManager::GameAction::SELECT_MEEPLE_POS;
+    if (firstFrameOfState){
+        startPondering(selectedMeeple->getLogicalMeeple());
+    }
 	//clicked meeple -> start to drag
     if (inputEvents.pressedLeftMouse && selectedMeeple->containsPosition(inputEvents.mousePosition)){
 		originalMeeplePosition = selectedMeeple->getPosition();
@@ -574,6 +599,7 @@ Game::LoopState Game::humanSelectMeeplePosition(InputEvents inputEvents){
 Game::LoopState Game::tcStartSelectMeeplePosition(){
 	assert(players[activePlayerIndex]->type == Player::TC);
 	todoText = RTextManager::GameAction::SELECT_MEEPLE_POS;
+    aiThinkClock.restart();
     players[activePlayerIndex]->controller->run_selectMeeplePosition(*gameStates[activePlayerIndex], *(selectedMeeple->getLogicalMeeple()));
 	return TC_WAIT_FOR_SELECTED_MEEPLE_POSITION;
 }
@@ -601,7 +627,7 @@ Game::LoopState Game::moveMeepleToSelectedPosition(float elapsedTime){
         moveMeepleAnimationDistance = sqrt(delta.x*delta.x + delta.y * delta.y);
 
         moveMeepleAnimationMaxLiftDistance = MOVE_MEEPLE_ANIMATION_MAX_LIFT_DISTANCE.get();
-        remainingThinkTime = players[activePlayerIndex]->meeplePositionThinkTime.get();
+        remainingThinkTime = players[activePlayerIndex]->meeplePositionThinkTime.get() - aiThinkClock.getElapsedTime().asSeconds();
     }
 	   
     if (remainingThinkTime > 0){                //Time, before the AI starts moving the meeple
@@ -665,6 +691,7 @@ Game::LoopState Game::checkEndCondition(){
 		}
         soundManager->getMusic(SoundManager::MEEPLE_WIN_DROP)->play();
 		gameMenu->setMenuState((activePlayerIndex == 0) ? GameWinner::PLAYER_1 : GameWinner::PLAYER_2);
+		stopPondering();
 		return DISPLAY_END_SCREEN;
 	}
     
@@ -673,6 +700,7 @@ Game::LoopState Game::checkEndCondition(){
 			    std::cout << "Tie! There is no winner." << std::endl;
 	    #endif
 		gameMenu->setMenuState(GameWinner::TIE);
+		stopPondering();
 		return DISPLAY_END_SCREEN;
 	}
 	return INIT_STATE;
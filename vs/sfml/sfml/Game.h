@@ -124,6 +124,7 @@ private:
         
     //moveMeepleToSelectedPosition & highlightSelectedMeeple
         float remainingThinkTime;                       //Remaining time, until the animation starts
+        sf::Clock aiThinkClock;                         //Started, when the AI starts its task: the time, which the AI needed, is subtracted from the think time
                         
     //End-Screen: rainbow-animation  for winCombination
         RMeeple* winningCombiRMeeples[4];
@@ -151,6 +152,8 @@ private:
         InputEvents pollEvents();
         void reset();                               //Reinitialises the object for another round
         void switchActivePlayer();
+        void startPondering(const Meeple* meepleToSet);      //An AI opponent of the active (human) player thinks about its next move during the human's turn
+        void stopPondering();
 	    void createMeepleDust(sf::FloatRect fieldBounds);        
     /*Game& operator = (const Game&);*/
 public:
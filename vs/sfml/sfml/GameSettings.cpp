@@ -1,6 +1,8 @@
 #include "GameSettings.h"
 
 #include <assert.h>
+#include <thread>
+#include <algorithm>
 
 #include "ThreadController.h"
 
@@ -9,9 +11,13 @@
 #include "RandomAI.h"
 #include "ThinkingAI.h"
 #include "SmartAI.h"
+#include "SolverAI.h"
+#include "MctsAI.h"
+#include "Tablebase.h"
+#include "OpeningBook.h"
 
 
-GameSettings::GameSettings() : simulator(0), threadedSimulator(false), fast(false), noAIsim(false){
+GameSettings::GameSettings() : simulator(0), threadedSimulator(false), perftDepth(0), tablebaseEmptyFields(0), tablebaseGames(TABLEBASE_DEFAULT_GAMES), openingBookPlies(0), openingBookPlayouts(OPENING_BOOK_DEFAULT_PLAYOUTS), tuneIterations(0), tuneGames(HEURISTIC_TUNING_DEFAULT_GAMES), fast(false), noAIsim(false), searchThreads(0){
     playerType[0] = HUMAN;
 	playerType[1] = SMART_AI;
     avatar[0] = ResourceManager::PROFESSOR_JENKINS;
@@ -21,6 +27,19 @@ GameSettings::GameSettings() : simulator(0), threadedSimulator(false), fast(fals
 }
 
 
+//Resolves the default of GameSettings::searchThreads
+static unsigned int getSearchThreadCount(const GameSettings& settings){
+    if (settings.searchThreads > 0){
+        return settings.searchThreads;
+    }
+    if (settings.simulator > 0){
+        return 1;
+    }
+    unsigned int cores = std::thread::hardware_concurrency();       //may be 0, if it is unknown
+    return (cores > 2) ? std::min(cores - 1, static_cast<unsigned int>(SOLVER_MAX_THREADS)) : 1;     //The search threads are stored in arrays of SOLVER_MAX_THREADS
+}
+
+
 I_Player* createI_Player(const GameSettings& settings, uint8_t playerNum){
     assert(settings.playerType[playerNum] != GameSettings::HUMAN);      //There is no I_Player for a human
 
@@ -29,6 +48,8 @@ I_Player* createI_Player(const GameSettings& settings, uint8_t playerNum){
     case GameSettings::RANDOM_AI:     return new RandomAI();
     case GameSettings::THINKING_AI:   return new ThinkingAI(settings.aiOptions[playerNum].useIntelligentMeepleChoosing, settings.aiOptions[playerNum].useIntelligentMeeplePositioning);
     case GameSettings::SMART_AI:      return new SmartAI(settings.aiOptions[playerNum].useIntelligentMeepleChoosing, settings.aiOptions[playerNum].useIntelligentMeeplePositioning);
+    case GameSettings::SOLVER_AI:     return new SolverAI(settings.searchLimits[playerNum], getSearchThreadCount(settings));
+    case GameSettings::MCTS_AI:       return new MctsAI(settings.searchLimits[playerNum], getSearchThreadCount(settings));
     default: assert(false);           return new StupidAI();
     }
 }
@@ -43,8 +64,6 @@ Player* createPlayer(const GameSettings& settings, uint8_t playerNum){
         p->type = Player::HUMAN;
     }else{
         p->type = Player::TC;
-        I_Player* i_player = createI_Player(settings, playerNum);
-        p->controller = new ThreadController(*i_player);
 
         if (settings.fast){
             p->meeplePositionThinkTime = { 0, 0 }; p->meepleChoosingThinkTime = { 0, 0 };
@@ -54,9 +73,19 @@ Player* createPlayer(const GameSettings& settings, uint8_t playerNum){
                 case GameSettings::RANDOM_AI:     p->meeplePositionThinkTime = { 0.5, 1.5 };    p->meepleChoosingThinkTime = { 0, 1 };      break;
                 case GameSettings::THINKING_AI:   p->meeplePositionThinkTime = { 0.8, 2.2 };    p->meepleChoosingThinkTime = { 0.5, 1.8 };  break;
                 case GameSettings::SMART_AI:      p->meeplePositionThinkTime = { 1, 3 };        p->meepleChoosingThinkTime = { 1, 2 };      break;
+                case GameSettings::SOLVER_AI:     p->meeplePositionThinkTime = { 1, 3 };        p->meepleChoosingThinkTime = { 0.5, 1 };    break;
+                case GameSettings::MCTS_AI:       p->meeplePositionThinkTime = { 1, 3 };        p->meepleChoosingThinkTime = { 0.5, 1 };    break;
                 default: assert(false);           p->meeplePositionThinkTime = { 0, 0 };        p->meepleChoosingThinkTime = { 0, 0 };      break;
             }
         }
+
+        //The think time isn't only waited for: a searching AI uses the minimal think time to search (the game only waits for the rest of it)
+        GameSettings playerSettings = settings;
+        if (playerSettings.searchLimits[playerNum].isDefault() && p->meeplePositionThinkTime.min > 0){
+            playerSettings.searchLimits[playerNum].moveTime = p->meeplePositionThinkTime.min;
+        }
+        I_Player* i_player = createI_Player(playerSettings, playerNum);
+        p->controller = new ThreadController(*i_player);
     }
     return p;
 }
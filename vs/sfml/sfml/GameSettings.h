@@ -1,7 +1,9 @@
 #pragma once
 #include <stdint.h>
+#include <string>
 
 #include "Player.h"
+#include "SearchLimits.h"
 
 
 struct AiOptions{
@@ -17,11 +19,22 @@ struct GameSettings{
         STUPID_AI,
         RANDOM_AI,
         THINKING_AI,
-        SMART_AI
+        SMART_AI,
+        SOLVER_AI,
+        MCTS_AI
     };
 
     unsigned int simulator;                 //>0: use the simulator instead of the graphical output. Numer = number of games to simulate
     bool threadedSimulator;                 //true: the threadedSimulator should be used
+    std::string benchmark;                  //not empty: run this benchmark suite instead of the game (see Benchmark.h)
+    unsigned int perftDepth;                //>0: count the nodes of the game tree up to this depth instead of running the game (see Perft.h)
+    std::string perftPosition;              //Start position for perft (see Position::fromString()); empty: beginning of the game
+    unsigned int tablebaseEmptyFields;      //>0: generate the endgame tablebase for positions with up to this number of empty fields instead of running the game (see Tablebase.h)
+    unsigned int tablebaseGames;            //Number of sampled games for the tablebase
+    unsigned int openingBookPlies;          //>0: generate the opening book for this number of plies instead of running the game (see OpeningBook.h)
+    unsigned int openingBookPlayouts;       //Playouts per position of the opening book
+    unsigned int tuneIterations;            //>0: tune the parameters of the AI of player 1 (thinking or smart) with this number of SPSA iterations instead of running the game (see HeuristicParameters.h)
+    unsigned int tuneGames;                 //Self-play games per tuning iteration
     
     PlayerType playerType[2];
     ResourceManager::ResourceRect avatar[2];
@@ -34,6 +47,8 @@ struct GameSettings{
 
     //These options are passed to the AI's (if neccessary):
     AiOptions aiOptions[2];
+    unsigned int searchThreads;             //Number of threads for searching AIs; 0: all cores but the one for rendering (the simulator uses 1 thread, to get reproducible results)
+    SearchLimits searchLimits[2];           //For searching AIs; default: in the graphical game, the AI may use its minimal think time (see createPlayer())
 
     GameSettings();
 };
@@ -8,6 +8,7 @@
 #include <assert.h>
 #include <string>
 #include <iostream>
+#include <sstream>
 
 
 GameSimulator::GameSimulator(I_Player& player1, I_Player& player2) : board(new Board()){
@@ -59,6 +60,15 @@ GameWinner::Enum GameSimulator::runManyGames(unsigned int cycles, bool printStat
     }
     if (printState){
         std::cout << "Player 1 won " << pw1 << " times, and Player 2 won " << pw2 << " times. There were " << ties << " Ties." << std::endl;
+        for (unsigned int p = 0; p < 2; ++p){
+            std::ostringstream statistics;
+            player[p]->printStatistics(statistics);
+            std::istringstream lines(statistics.str());
+            std::string line;
+            while (std::getline(lines, line)){
+                std::cout << "Player " << p + 1 << " " << line << std::endl;
+            }
+        }
     }
     if (pw1 == pw2){
         return GameWinner::TIE;
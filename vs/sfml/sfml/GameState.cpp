@@ -1,15 +1,19 @@
 #include "GameSimulator.h"
 
+#include <assert.h>
+
 #include "MeepleBag.h"
+#include "Meeple.h"
+#include "Zobrist.h"
 
 
 
 GameState::GameState(MeepleBag* ownBag, MeepleBag* opponentBag, Board* board) :
-    ownBag(ownBag), opponentBag(opponentBag), board(board), cloned(false){
+    ownBag(ownBag), opponentBag(opponentBag), board(board), cloned(false), undoCount(0){
 }
 
 GameState::GameState(const GameState& base) :
-    ownBag(new MeepleBag(*base.ownBag)), opponentBag(new MeepleBag(*base.opponentBag)), board(new Board(*base.board, ownBag, opponentBag)), cloned(true){
+    ownBag(new MeepleBag(*base.ownBag)), opponentBag(new MeepleBag(*base.opponentBag)), board(new Board(*base.board, ownBag, opponentBag)), cloned(true), undoCount(0){
 }
 
 GameState::~GameState(){
@@ -18,4 +22,46 @@ GameState::~GameState(){
         delete opponentBag;
         delete board;
     }
-}
\ No newline at end of file
+}
+
+
+void GameState::play(BoardPos position, const Meeple& meeple){
+    assert(undoCount < MAX_UNDO_COUNT);
+    MeepleBag* bag = (ownBag->getBagColor() == meeple.getColor()) ? ownBag : opponentBag;
+    int index = bag->getMeepleIndex(meeple);
+    assert(index >= 0);     //The meeple has to be in the bag
+
+    Meeple* m = bag->removeMeeple(static_cast<unsigned int>(index));
+    board->setMeeple(position, *m);
+
+    UndoEntry& entry = undoStack[undoCount++];
+    entry.position = position;
+    entry.bag = bag;
+    entry.bagIndex = static_cast<uint8_t>(index);
+}
+
+void GameState::undo(){
+    assert(undoCount > 0);
+    UndoEntry& entry = undoStack[--undoCount];
+    Meeple* m = board->removeMeeple(entry.position);
+    assert(m != nullptr);
+    entry.bag->undoRemoveMeeple(*m, entry.bagIndex);
+}
+
+unsigned int GameState::getUndoCount() const{
+    return undoCount;
+}
+
+uint64_t GameState::getHash(const Meeple* meepleToSet) const{
+    uint64_t hash = board->getHash() ^ ownBag->getHash() ^ opponentBag->getHash();
+    if (meepleToSet != nullptr){
+        hash ^= ZOBRIST.meepleToSet[meepleToSet->getCode()];
+        if (ownBag->isMeepleInBag(*meepleToSet) || opponentBag->isMeepleInBag(*meepleToSet)){
+            hash ^= ZOBRIST.inBag[meepleToSet->getCode()];      //The chosen meeple doesn't count as a meeple in the bag
+        }
+    }
+    if (ownBag->getBagColor() == MeepleColor::BLACK){
+        hash ^= ZOBRIST.blackToMove;
+    }
+    return hash;
+}
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <cstdint>
+
+#include "Board.h"
+
 class MeepleBag;
-class Board;
+class Meeple;
 
 struct GameWinner{
 	enum Enum{
@@ -13,11 +17,22 @@ struct GameWinner{
 };
 
 
+#define MAX_UNDO_COUNT 16           //There are only 16 moves per game
+
+
 //This data is given to the players/AIs, to calculate their next moves
 //Note: this class doesn't hide its members, they are public and not-const. Care about not-const GameStates!
 class GameState{
 private:
     bool cloned;                    //if true, the struct has been generated with clone(), and the members need to be deleted()
+
+    struct UndoEntry{               //Everything that is needed to revert a move of play()
+        BoardPos position;          //The field, where the meeple has been set
+        MeepleBag* bag;             //The bag, from which the meeple has been taken
+        uint8_t bagIndex;           //The meeple's index within the bag, before it has been removed
+    };
+    UndoEntry undoStack[MAX_UNDO_COUNT];
+    uint8_t undoCount;              //Number of moves on the undoStack
 public:
 	MeepleBag* ownBag;          //The meeples which are owned by the AI
 	MeepleBag* opponentBag;     //The meeples which are owned by the oppnent's AI
@@ -26,4 +41,12 @@ public:
     GameState(MeepleBag* ownBag, MeepleBag* opponentBag, Board* board);         //Doesn't copy the values - asigns them
     GameState(const GameState& base);         //Returns a copy of the gameState; Needs to be deleted()
     ~GameState();
+
+    //Make/unmake-API for searching AIs: changes the board and the bags in place, without any allocations
+    //Note: the board and the bags are shared with the game - use it on a copy, or revert all moves before returning control
+        void play(BoardPos position, const Meeple& meeple);     //Removes the meeple from its bag (own or opponent's bag, depending on the color), and sets it to the position
+        void undo();                                            //Reverts the last move of play()
+        unsigned int getUndoCount() const;                      //Number of moves, which can be reverted
+
+    uint64_t getHash(const Meeple* meepleToSet) const;          //Zobrist-hash of the board, the bags, the meepleToSet (may be nullptr; may still be in its bag) and the side to move (= color of ownBag); same as Position::fromGameState(*this, meepleToSet).getHash()
 };
@@ -0,0 +1,224 @@
+#include "HeuristicParameters.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "ThinkingAI.h"
+#include "SmartAI.h"
+#include "GameSimulator.h"
+
+
+struct ParameterInfo{
+    const char* name;
+    int defaultValue;
+    int min;
+    int max;
+    int step;
+};
+
+//[HeuristicParameter::Enum]
+static const ParameterInfo PARAMETER_INFO[HeuristicParameter::COUNT] = {
+    { "property_match_points",      5,      1,      20,     1 },
+    { "property_blocked_points",    -2,     -20,    -1,     1 },
+    { "win_bonus",                  20,     0,      200,    4 },
+    { "select_max_weight",          8,      0,      32,     1 },
+    { "select_average_weight",      2,      0,      32,     1 },
+    { "smart_win_points",           1000,   1000,   5000,   100 },
+    { "smart_match_points",         1,      0,      4,      1 },        //11 of them must stay below smart_opponent_penalty
+    { "smart_opponent_penalty",     50,     0,      90,     4 }         //must not exceed smart_win_points / 11 (max. 11 properties of a field may count)
+};
+
+
+static HeuristicParameters globalParameters;
+
+HeuristicParameters& HeuristicParameters::getGlobal(){
+    return globalParameters;
+}
+
+
+HeuristicParameters::HeuristicParameters(){
+    for (unsigned int p = 0; p < HeuristicParameter::COUNT; ++p){
+        values[p] = PARAMETER_INFO[p].defaultValue;
+    }
+}
+
+int HeuristicParameters::get(HeuristicParameter::Enum parameter) const{
+    assert(parameter < HeuristicParameter::COUNT);
+    return values[parameter];
+}
+
+void HeuristicParameters::set(HeuristicParameter::Enum parameter, int value){
+    assert(parameter < HeuristicParameter::COUNT);
+    values[parameter] = std::max(getMin(parameter), std::min(getMax(parameter), value));
+}
+
+const char* HeuristicParameters::getName(HeuristicParameter::Enum parameter){
+    return PARAMETER_INFO[parameter].name;
+}
+
+int HeuristicParameters::getMin(HeuristicParameter::Enum parameter){
+    return PARAMETER_INFO[parameter].min;
+}
+
+int HeuristicParameters::getMax(HeuristicParameter::Enum parameter){
+    return PARAMETER_INFO[parameter].max;
+}
+
+int HeuristicParameters::getStep(HeuristicParameter::Enum parameter){
+    return PARAMETER_INFO[parameter].step;
+}
+
+
+bool HeuristicParameters::load(const std::string& path){
+    std::ifstream input(path.c_str());
+    if (!input){
+        return false;
+    }
+    std::string line;
+    while (std::getline(input, line)){
+        std::istringstream stream(line);
+        std::string name;
+        int value;
+        if (!(stream >> name) || name[0] == '#'){
+            continue;       //empty line or comment
+        }
+        bool known = false;
+        for (unsigned int p = 0; p < HeuristicParameter::COUNT; ++p){
+            if (name == PARAMETER_INFO[p].name && (stream >> value)){
+                set(static_cast<HeuristicParameter::Enum>(p), value);
+                known = true;
+            }
+        }
+        if (!known){
+            std::cout << "Ignoring the line \"" << line << "\" in " << path << std::endl;
+        }
+    }
+    return true;
+}
+
+bool HeuristicParameters::save(const std::string& path) const{
+    std::ofstream output(path.c_str(), std::ios::trunc);
+    output << "# Weights of the ThinkingAI and the SmartAI (see HeuristicParameters.h)" << std::endl << toString();
+    if (!output){
+        std::cout << "Couldn't write " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::string HeuristicParameters::toString() const{
+    std::ostringstream output;
+    for (unsigned int p = 0; p < HeuristicParameter::COUNT; ++p){
+        output << PARAMETER_INFO[p].name << ' ' << values[p] << std::endl;
+    }
+    return output.str();
+}
+
+
+
+#define SPSA_LEARNING_RATE 1.f          //Change of a parameter (in perturbations) per iteration, if one side wins all games
+#define SPSA_PERTURBATION 2.f           //Perturbation in the first iteration (in steps of the parameter); decays slowly
+
+static HeuristicParameters getRoundedParameters(const std::vector<float>& theta){
+    HeuristicParameters parameters;
+    for (unsigned int p = 0; p < HeuristicParameter::COUNT; ++p){
+        parameters.set(static_cast<HeuristicParameter::Enum>(p), static_cast<int>(floor(theta[p] + 0.5f)));
+    }
+    return parameters;
+}
+
+//Plays the games between both parameter sets (each one is player 1 in half of the games), and adds 1 point per win and 0.5 per tie to the points of the set
+//The random numbers of rand() are per thread (MSVC), and start with the seed 1 --> each thread needs its own seed, otherwise all threads play the same games
+static void playTuningGames(bool smartAI, const HeuristicParameters* parameters, unsigned int seed, unsigned int firstGame, unsigned int games, float* points){
+    srand(seed);
+    I_Player* players[2];
+    for (unsigned int s = 0; s < 2; ++s){
+        players[s] = smartAI ? static_cast<I_Player*>(new SmartAI(true, true, parameters[s])) : new ThinkingAI(true, true, parameters[s]);
+    }
+    GameSimulator firstSetStarts(*players[0], *players[1]);
+    GameSimulator secondSetStarts(*players[1], *players[0]);
+    for (unsigned int g = firstGame; g < firstGame + games; ++g){
+        GameSimulator& simulator = (g % 2 == 0) ? firstSetStarts : secondSetStarts;
+        const GameWinner::Enum winner = simulator.runGame();
+        simulator.reset();
+        if (winner == GameWinner::TIE){
+            points[0] += 0.5f;
+            points[1] += 0.5f;
+        }else{
+            points[(winner == GameWinner::PLAYER_1) == (g % 2 == 0) ? 0 : 1] += 1.f;
+        }
+    }
+    delete players[1];
+    delete players[0];
+}
+
+bool tuneHeuristicParameters(bool smartAI, unsigned int iterations, unsigned int gamesPerIteration, const std::string& path){
+    assert(iterations > 0 && gamesPerIteration > 0);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const unsigned int threads = std::max(1u, std::min(std::thread::hardware_concurrency(), gamesPerIteration));
+    std::cout << "Tuning the " << (smartAI ? "SmartAI" : "ThinkingAI") << " with " << iterations << " SPSA iterations of " << gamesPerIteration << " games (" << threads << " threads)..." << std::endl;
+
+    std::vector<float> theta(HeuristicParameter::COUNT);
+    for (unsigned int p = 0; p < HeuristicParameter::COUNT; ++p){
+        theta[p] = static_cast<float>(HeuristicParameters::getGlobal().get(static_cast<HeuristicParameter::Enum>(p)));
+    }
+
+    const float stability = iterations / 10.f;      //Keeps the first steps small
+    for (unsigned int k = 0; k < iterations; ++k){
+        const float learningRate = SPSA_LEARNING_RATE * pow(1.f + stability, 0.602f) / pow(k + 1.f + stability, 0.602f);
+        const float perturbation = SPSA_PERTURBATION / pow(k + 1.f, 0.101f);
+
+        //The perturbed parameter sets ([0] = +, [1] = -):
+        std::vector<float> delta(HeuristicParameter::COUNT);
+        std::vector<float> perturbed[2] = { theta, theta };
+        for (unsigned int p = 0; p < HeuristicParameter::COUNT; ++p){
+            delta[p] = (rand() % 2 == 0) ? 1.f : -1.f;
+            const float change = perturbation * HeuristicParameters::getStep(static_cast<HeuristicParameter::Enum>(p)) * delta[p];
+            perturbed[0][p] += change;
+            perturbed[1][p] -= change;
+        }
+        const HeuristicParameters parameters[2] = { getRoundedParameters(perturbed[0]), getRoundedParameters(perturbed[1]) };
+
+        //The games, split into equal parts for the threads:
+        std::vector<float> points(2 * threads, 0.f);
+        std::vector<std::thread> workers;
+        const unsigned int baseSeed = static_cast<unsigned int>(rand());
+        for (unsigned int t = 0; t < threads; ++t){
+            const unsigned int firstGame = gamesPerIteration * t / threads;
+            const unsigned int games = gamesPerIteration * (t + 1) / threads - firstGame;
+            workers.push_back(std::thread(playTuningGames, smartAI, parameters, baseSeed + t, firstGame, games, &points[2 * t]));
+        }
+        float score = 0.f;          //Result of the + set: 1 = won all games, -1 = lost all games
+        for (unsigned int t = 0; t < threads; ++t){
+            workers[t].join();
+            score += (points[2 * t] - points[2 * t + 1]) / gamesPerIteration;
+        }
+
+        //Move towards the winner:
+        for (unsigned int p = 0; p < HeuristicParameter::COUNT; ++p){
+            const HeuristicParameter::Enum parameter = static_cast<HeuristicParameter::Enum>(p);
+            theta[p] += learningRate * perturbation * HeuristicParameters::getStep(parameter) * score * delta[p];
+            theta[p] = std::max(static_cast<float>(HeuristicParameters::getMin(parameter)), std::min(static_cast<float>(HeuristicParameters::getMax(parameter)), theta[p]));
+        }
+
+        std::cout << "  iteration " << k + 1 << ": score of the + parameters " << std::fixed << std::setprecision(3) << score << " ("
+            << std::setprecision(1) << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << " s)" << std::endl;
+        if (!getRoundedParameters(theta).save(path)){
+            return false;
+        }
+    }
+
+    HeuristicParameters::getGlobal() = getRoundedParameters(theta);
+    std::cout << "Wrote the tuned parameters to " << path << ":" << std::endl << HeuristicParameters::getGlobal().toString();
+    return true;
+}
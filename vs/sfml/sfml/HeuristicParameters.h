@@ -0,0 +1,56 @@
+#pragma once
+#include <string>
+
+#include "config.h"
+
+
+//The weights of the heuristic AIs (ThinkingAI, SmartAI), which can be tuned by self-play (see tuneHeuristicParameters())
+//The AIs copy the parameters, when they are created - by default the global parameters, which are loaded from HEURISTIC_PARAMETERS_FILE at startup
+//The file is a text file with one "name value" line per parameter; missing parameters keep their default
+
+
+#define HEURISTIC_PARAMETERS_FILE WORKING_DIR "heuristic.params"
+#define HEURISTIC_TUNING_DEFAULT_GAMES 1000         //Self-play games per SPSA iteration
+
+
+struct HeuristicParameter{
+    enum Enum{
+        PROPERTY_MATCH_POINTS,          //ThinkingAI: points per meeple in a line, which shares a property with the meepleToSet (3 of them can win)
+        PROPERTY_BLOCKED_POINTS,        //ThinkingAI: points of a property, which can't lead to a win in the line anymore (< 0)
+        WIN_BONUS,                      //ThinkingAI: bonus for a line, which the meepleToSet wins
+        SELECT_MAX_WEIGHT,              //Choosing a meeple: weight of the best field of the opponent's score map
+        SELECT_AVERAGE_WEIGHT,          //Choosing a meeple: weight of the average of the opponent's score map
+        SMART_WIN_POINTS,               //SmartAI: points of a line, which the meepleToSet wins (HIGHEST_SINGLE_POINTS)
+        SMART_MATCH_POINTS,             //SmartAI: points of a property, which 1 meeple of the line shares with the meepleToSet
+        SMART_OPPONENT_PENALTY,         //SmartAI: penalty of a property, which 2 meeples share, if all of the opponent's meeples have it (divided by their number)
+        COUNT
+    };
+};
+
+
+class HeuristicParameters{
+private:
+    int values[HeuristicParameter::COUNT];
+public:
+    HeuristicParameters();                                  //The default values (the original weights of the AIs)
+
+    static HeuristicParameters& getGlobal();                //The parameters, with which the AIs are created by default
+
+    int get(HeuristicParameter::Enum parameter) const;
+    void set(HeuristicParameter::Enum parameter, int value);    //The value is clamped to the range of the parameter
+
+    static const char* getName(HeuristicParameter::Enum parameter);
+    static int getMin(HeuristicParameter::Enum parameter);
+    static int getMax(HeuristicParameter::Enum parameter);
+    static int getStep(HeuristicParameter::Enum parameter);    //Typical change of the value (the perturbation of the tuning)
+
+    bool load(const std::string& path);                     //Returns false, if the file doesn't exist (the values are kept)
+    bool save(const std::string& path) const;
+    std::string toString() const;                           //All parameters in the format of the file
+};
+
+
+//Tunes the parameters of the ThinkingAI or the SmartAI by SPSA (simultaneous perturbation stochastic approximation), starting with the global parameters:
+//In each iteration, all parameters are perturbed at once in random directions (+/-); the AI with the parameters + perturbation plays against the AI with the parameters - perturbation,
+//and the parameters are moved towards the winner. The games run on all cores; the parameters are saved to the file after each iteration
+bool tuneHeuristicParameters(bool smartAI, unsigned int iterations, unsigned int gamesPerIteration, const std::string& path);
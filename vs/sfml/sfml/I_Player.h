@@ -1,16 +1,27 @@
 #pragma once
+#include <atomic>
+#include <ostream>
 
 class GameState;
 class Board;
 class MeepleBag;
 class Meeple;
 struct BoardPos;
+struct Position;
 
 
 class I_Player{
 public:
+    virtual ~I_Player(){}                       //AIs are deleted through this interface (see ThreadController)
+
     virtual const Meeple& selectOpponentsMeeple(const GameState& gameState) = 0;
     virtual BoardPos selectMeeplePosition(const GameState& gameState, const Meeple& meepleToSet) = 0;
+
+    //Called during the opponent's turn with the opponent's position: the player may prepare its next move (e.g. fill its search tree), until stop is set
+    //The results have to be kept by the player itself - the next select...() call isn't necessarily one of the pondered positions
+    virtual void ponder(const Position& /*position*/, const std::atomic<bool>& /*stop*/){}
+
+    virtual void printStatistics(std::ostream& /*output*/) const{}     //Prints statistics of the player (e.g. of its caches) after a simulation; most players have none
     
     void reset();                               //Reinitialises the object for a new game
 };
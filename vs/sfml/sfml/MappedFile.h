@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+
+//Read-only memory mapping of a whole file (CreateFileMapping on Windows, mmap elsewhere)
+//The content isn't copied: the operating system loads the pages on the first access, and shares them between all processes, which map the same file
+class MappedFile{
+private:
+    const unsigned char* data;
+    size_t size;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#else
+    int fileDescriptor;
+#endif
+
+    MappedFile(const MappedFile&);
+    MappedFile& operator = (const MappedFile&);
+public:
+    MappedFile();
+    ~MappedFile();
+
+    bool open(const std::string& path);         //Maps the file; returns false, if it doesn't exist, is empty, or can't be mapped
+    void close();
+    bool isOpen() const;
+
+    const unsigned char* getData() const;       //nullptr, if no file is mapped
+    size_t getSize() const;
+};
@@ -0,0 +1,425 @@
+#include "MctsAI.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <stdlib.h>
+#include <math.h>
+#include <climits>
+#include <thread>
+#include <vector>
+
+#include "Meeple.h"
+#include "MeepleBag.h"
+#include "GameState.h"
+#include "Tablebase.h"
+#include "OpeningBook.h"
+
+
+
+//Returns the index of a random set bit of the mask; the mask must not be 0
+static uint8_t getRandomBit(uint16_t mask, PlayoutRandom& random){
+    for (unsigned int skip = random.below(popcount16(mask)); skip > 0; --skip){
+        mask &= mask - 1;
+    }
+    return lowestBitIndex(mask);
+}
+
+static uint16_t getOpponentCodes(const Position& position){      //The meeples, which the side to move can choose for the opponent
+    return position.available & MEEPLE_PROPERTY_MASKS[getPropertyPlaneIndex(MeepleProperty::MEEPLE_COLOR, position.sideToMove ^ 1)];
+}
+
+
+uint8_t playRandomGame(Position position, PlayoutRandom& random){
+    if (position.meepleToSet != NO_MEEPLE && (getWinningCodes(position) & (1 << position.meepleToSet)) != 0){
+        return position.sideToMove;
+    }
+    //From here on, the meepleToSet never wins: a meeple is only given, if it can't win (or if every meeple wins - then the game is decided)
+    for (;;){
+        if (position.meepleToSet != NO_MEEPLE){
+            position.setMeeple(getRandomBit(static_cast<uint16_t>(~position.occupied), random), position.meepleToSet);
+            if (position.isFull()){
+                return MCTS_TIE;
+            }
+        }
+
+        const uint16_t gives = getOpponentCodes(position);
+        const uint16_t safeGives = gives & static_cast<uint16_t>(~getWinningCodes(position));
+        if (safeGives == 0){
+            return static_cast<uint8_t>(position.sideToMove ^ 1);       //The opponent wins with any meeple
+        }
+        position.meepleToSet = getRandomBit(safeGives, random);
+        position.available &= static_cast<uint16_t>(~(1 << position.meepleToSet));
+        position.sideToMove = static_cast<uint8_t>(position.sideToMove ^ 1);
+    }
+}
+
+
+
+MctsAI::MctsAI(const SearchLimits& limits, unsigned int threadCount) :
+    expectedGive(NO_MEEPLE), limits(limits), threadCount(std::max(1u, std::min(threadCount, static_cast<unsigned int>(MCTS_MAX_THREADS)))), random(static_cast<uint32_t>(rand())), activeArena(0), nodeCount(0), hasTree(false),
+    maxPlayouts(0), startedPlayouts(0), stopped(false), ponderStop(nullptr), pondered(false), timedVisits(0), playouts(0), reusedNodes(0), bestWinRate(0){
+    expectedPosition = Position::empty();
+    rootPosition = Position::empty();
+
+    //The arenas are allocated once (new[] doesn't initialize the nodes --> the memory is only touched, when the tree grows)
+    arenas[0] = new MctsNode[MCTS_MAX_NODES];
+    arenas[1] = new MctsNode[MCTS_MAX_NODES];
+    nodes = arenas[activeArena];
+}
+
+MctsAI::~MctsAI(){
+    delete[] arenas[0];
+    delete[] arenas[1];
+}
+
+
+const Meeple& MctsAI::selectOpponentsMeeple(const GameState& gameState){
+    Position position = Position::fromGameState(gameState, nullptr);
+    uint8_t give = expectedGive;
+    if (give == NO_MEEPLE || position != expectedPosition){     //The meeple hasn't been chosen together with the last position (e.g. first turn of the game)
+        give = searchBestMove(position).give;
+    }
+    expectedGive = NO_MEEPLE;
+
+    for (unsigned int i = 0; i < gameState.opponentBag->getMeepleCount(); ++i){
+        if (gameState.opponentBag->getMeeple(i)->getCode() == give){
+            return *gameState.opponentBag->getMeeple(i);
+        }
+    }
+    assert(false);      //the meeple has to be in the opponent's bag
+    return *gameState.opponentBag->getMeeple(0);
+}
+
+BoardPos MctsAI::selectMeeplePosition(const GameState& gameState, const Meeple& meepleToSet){
+    Position position = Position::fromGameState(gameState, &meepleToSet);
+    CompoundMove best = searchBestMove(position);
+    assert(best.field != NO_FIELD);
+
+    //Remember the meeple for the opponent, it has been found by the same search:
+    expectedPosition = position;
+    expectedPosition.setMeeple(best.field, position.meepleToSet);
+    expectedPosition.meepleToSet = NO_MEEPLE;
+    expectedGive = best.give;
+
+    return BoardPos::fromFieldIndex(best.field);
+}
+
+unsigned long long MctsAI::getPlayoutCount() const{
+    return playouts;
+}
+
+unsigned int MctsAI::getNodeCount() const{
+    return nodeCount.load();
+}
+
+unsigned int MctsAI::getReusedNodeCount() const{
+    return reusedNodes;
+}
+
+float MctsAI::getBestWinRate() const{
+    return bestWinRate;
+}
+
+
+
+CompoundMove MctsAI::searchBestMove(const Position& position){
+    assert(!position.isFull() && !position.checkWinSituation());
+    const bool afterPondering = pondered;
+    pondered = false;
+
+    //A winning move doesn't need a search:
+    MoveList wins;
+    generateMoves(position, wins, MoveFilter::WINS_ONLY);
+    if (wins.count > 0){
+        playouts = 0;
+        reusedNodes = 0;
+        bestWinRate = 1;
+        return wins.moves[0];
+    }
+    CompoundMove knownMove;
+    if (OpeningBook::getGlobal().probe(position, knownMove) || Tablebase::getGlobal().probe(position, knownMove)){
+        playouts = 0;
+        reusedNodes = 0;
+        bestWinRate = 0;
+        return knownMove;
+    }
+
+    timer.restart(limits);
+    prepareRoot(position);
+    maxPlayouts = (limits.playouts > 0) ? limits.playouts : (limits.moveTime > 0 ? ULLONG_MAX : MCTS_DEFAULT_PLAYOUTS);
+    if (afterPondering && reusedNodes > 0){
+        //The playouts of the pondering count - the decision may be finished already:
+        const unsigned long long visits = nodes[0].visits.load();
+        const unsigned long long budget = (limits.playouts == 0 && limits.moveTime > 0 && timedVisits > 0) ? timedVisits : maxPlayouts;
+        maxPlayouts = (visits < budget) ? budget - visits : 0;
+    }
+    runSearch(position);
+    if (limits.moveTime > 0 && stopped.load()){
+        timedVisits = nodes[0].visits.load();
+    }
+
+    //The most visited move is the most reliable one:
+    uint32_t best = MCTS_NO_NODE;
+    for (uint32_t child = nodes[0].firstChild.load(); child != MCTS_NO_NODE; child = nodes[child].nextSibling){
+        if (best == MCTS_NO_NODE || nodes[child].visits.load(std::memory_order_relaxed) > nodes[best].visits.load(std::memory_order_relaxed)){
+            best = child;
+        }
+    }
+    assert(best != MCTS_NO_NODE);
+    bestWinRate = 0.5f * nodes[best].score.load() / nodes[best].visits.load();
+    return nodes[best].move;
+}
+
+void MctsAI::ponder(const Position& position, const std::atomic<bool>& stop){
+    MoveList wins;
+    if (position.isFull() || position.checkWinSituation() || (generateMoves(position, wins, MoveFilter::WINS_ONLY), wins.count > 0)){
+        return;         //The opponent's move is obvious
+    }
+    timer.restart(SearchLimits());      //No deadline: the playouts go on, until stop is set (or the arena is full)
+    prepareRoot(position);
+    maxPlayouts = ULLONG_MAX;
+    ponderStop = &stop;
+    runSearch(position);
+    ponderStop = nullptr;
+    pondered = true;
+}
+
+void MctsAI::runSearch(const Position& position){
+    startedPlayouts.store(0);
+    stopped.store(false);
+
+    //The calling thread is one of the search threads:
+    unsigned long long completed[MCTS_MAX_THREADS];
+    std::vector<std::thread> helpers;
+    for (unsigned int t = 1; t < threadCount; ++t){
+        const uint32_t seed = random.next();
+        helpers.push_back(std::thread([this, &position, &completed, t, seed](){
+            PlayoutRandom helperRandom(seed);
+            runThread(position, helperRandom, completed[t]);
+        }));
+    }
+    runThread(position, random, completed[0]);
+    for (std::vector<std::thread>::iterator it = helpers.begin(); it != helpers.end(); ++it){
+        it->join();
+    }
+    playouts = 0;
+    for (unsigned int t = 0; t < threadCount; ++t){
+        playouts += completed[t];
+    }
+}
+
+void MctsAI::runThread(const Position& position, PlayoutRandom& random, unsigned long long& completed){
+    completed = 0;
+    for (;;){
+        const unsigned long long playout = startedPlayouts.fetch_add(1, std::memory_order_relaxed);
+        if (playout >= maxPlayouts || stopped.load(std::memory_order_relaxed)){
+            break;
+        }
+        if ((playout & (MCTS_TIME_CHECK_INTERVAL - 1)) == 0 && playout > 0 && (timer.isExpired()
+            || (ponderStop != nullptr && (ponderStop->load(std::memory_order_relaxed) || nodeCount.load(std::memory_order_relaxed) >= MCTS_MAX_NODES)))){
+            stopped.store(true, std::memory_order_relaxed);
+            break;
+        }
+        runPlayout(position, random);
+        ++completed;
+    }
+}
+
+
+//Returns the result of the game after the move (MCTS_OPEN, if it isn't known yet)
+//The result is known, if the move ends the game, or if the opponent can win immediately with the given meeple
+static uint8_t getOutcome(const Position& position, const CompoundMove& move){
+    Position after = playMove(position, move);
+    if (move.give == NO_MEEPLE){
+        return after.checkWinSituation() ? position.sideToMove : static_cast<uint8_t>(MCTS_TIE);
+    }
+    if (getWinningCodes(after) & (1 << move.give)){
+        return after.sideToMove;
+    }
+    return MCTS_OPEN;
+}
+
+
+uint32_t MctsAI::allocateNode(){
+    const uint32_t index = nodeCount.fetch_add(1, std::memory_order_relaxed);
+    if (index >= MCTS_MAX_NODES){
+        nodeCount.store(MCTS_MAX_NODES, std::memory_order_relaxed);     //Prevents an overflow of the counter
+        return MCTS_NO_NODE;
+    }
+    return index;
+}
+
+uint32_t MctsAI::expand(MctsNode& node, const Position& position, const MoveList& moves){
+    //The node is allocated before the move is claimed: a claimed move always gets its child (a lost race only wastes a node)
+    const uint32_t index = allocateNode();
+    if (index == MCTS_NO_NODE){
+        return MCTS_NO_NODE;
+    }
+    uint8_t move = node.childCount.load(std::memory_order_relaxed);
+    do{
+        if (move >= moves.count){
+            return MCTS_NO_NODE;        //Another thread has claimed the last move
+        }
+    } while (!node.childCount.compare_exchange_weak(move, static_cast<uint8_t>(move + 1), std::memory_order_relaxed));
+
+    MctsNode& child = nodes[index];
+    child.move = moves.moves[move];
+    child.mover = position.sideToMove;
+    child.outcome = getOutcome(position, child.move);
+    child.moveCount.store(0, std::memory_order_relaxed);
+    child.childCount.store(0, std::memory_order_relaxed);
+    child.visits.store(1, std::memory_order_relaxed);       //The playout, which expands the node
+    child.score.store(0, std::memory_order_relaxed);
+    child.firstChild.store(MCTS_NO_NODE, std::memory_order_relaxed);
+
+    //Publish the child (release: the other threads see all of its members, when they find it in the list):
+    uint32_t first = node.firstChild.load(std::memory_order_relaxed);
+    do{
+        child.nextSibling = first;
+    } while (!node.firstChild.compare_exchange_weak(first, index, std::memory_order_release, std::memory_order_relaxed));
+    return index;
+}
+
+uint32_t MctsAI::selectChild(const MctsNode& node) const{
+    const float logVisits = logf(static_cast<float>(node.visits.load(std::memory_order_relaxed)));
+    uint32_t best = MCTS_NO_NODE;
+    float bestValue = -1;
+    for (uint32_t child = node.firstChild.load(std::memory_order_acquire); child != MCTS_NO_NODE; child = nodes[child].nextSibling){
+        const float visits = static_cast<float>(nodes[child].visits.load(std::memory_order_relaxed));
+        const float value = 0.5f * nodes[child].score.load(std::memory_order_relaxed) / visits + MCTS_EXPLORATION * sqrtf(logVisits / visits);
+        if (value > bestValue){
+            bestValue = value;
+            best = child;
+        }
+    }
+    return best;
+}
+
+
+void MctsAI::prepareRoot(const Position& position){
+    const uint32_t subtree = hasTree ? findSubtree(position) : MCTS_NO_NODE;
+    uint32_t count = 0;
+    if (subtree != MCTS_NO_NODE){
+        //Compact the subtree into the other arena (the rest of the old tree is dropped):
+        activeArena ^= 1;
+        copySubtree(subtree, arenas[activeArena], count);
+        nodes = arenas[activeArena];
+    }else{
+        MctsNode& root = nodes[count++];
+        root.move.field = NO_FIELD;
+        root.move.give = NO_MEEPLE;
+        root.mover = static_cast<uint8_t>(position.sideToMove ^ 1);        //The root is the result of the opponent's last move
+        root.outcome = MCTS_OPEN;
+        root.moveCount.store(0);
+        root.childCount.store(0);
+        root.visits.store(0);
+        root.score.store(0);
+        root.firstChild.store(MCTS_NO_NODE);
+        root.nextSibling = MCTS_NO_NODE;
+    }
+    reusedNodes = (subtree != MCTS_NO_NODE) ? count : 0;
+    nodeCount.store(count);
+    rootPosition = position;
+    hasTree = true;
+}
+
+uint32_t MctsAI::findSubtree(const Position& position) const{
+    if (position == rootPosition){
+        return 0;
+    }
+    for (uint32_t child = nodes[0].firstChild.load(); child != MCTS_NO_NODE; child = nodes[child].nextSibling){
+        const Position afterOwnMove = playMove(rootPosition, nodes[child].move);
+        if (afterOwnMove == position){
+            return child;
+        }
+        for (uint32_t grandChild = nodes[child].firstChild.load(); grandChild != MCTS_NO_NODE; grandChild = nodes[grandChild].nextSibling){
+            if (playMove(afterOwnMove, nodes[grandChild].move) == position){
+                return grandChild;
+            }
+        }
+    }
+    return MCTS_NO_NODE;
+}
+
+uint32_t MctsAI::copySubtree(uint32_t index, MctsNode* target, uint32_t& targetCount) const{
+    const MctsNode& source = nodes[index];
+    const uint32_t copyIndex = targetCount++;
+    MctsNode& copy = target[copyIndex];
+    copy.move = source.move;
+    copy.mover = source.mover;
+    copy.outcome = source.outcome;
+    copy.moveCount.store(source.moveCount.load());
+    copy.childCount.store(source.childCount.load());
+    copy.visits.store(source.visits.load());
+    copy.score.store(source.score.load());
+    copy.firstChild.store(MCTS_NO_NODE);
+    copy.nextSibling = MCTS_NO_NODE;
+
+    uint32_t previous = MCTS_NO_NODE;
+    for (uint32_t child = source.firstChild.load(); child != MCTS_NO_NODE; child = nodes[child].nextSibling){
+        const uint32_t childCopy = copySubtree(child, target, targetCount);
+        if (previous == MCTS_NO_NODE){
+            copy.firstChild.store(childCopy);
+        }else{
+            target[previous].nextSibling = childCopy;
+        }
+        previous = childCopy;
+    }
+    return copyIndex;
+}
+
+
+void MctsAI::runPlayout(const Position& position, PlayoutRandom& random){
+    uint32_t path[FIELD_COUNT + 2];         //+2: the root, and the first turn without setting a meeple
+    unsigned int pathLength = 0;
+    Position current = position;
+    uint32_t index = 0;
+    nodes[index].visits.fetch_add(1, std::memory_order_relaxed);
+    path[pathLength++] = index;
+
+    uint8_t result;
+    for (;;){
+        MctsNode& node = nodes[index];
+        if (node.outcome != MCTS_OPEN){
+            result = node.outcome;
+            break;
+        }
+
+        //Expansion: the moves of a node are always generated in the same order --> the next unexpanded move is moves[childCount]
+        const uint8_t moveCount = node.moveCount.load(std::memory_order_relaxed);
+        if ((moveCount == 0 || node.childCount.load(std::memory_order_relaxed) < moveCount) && nodeCount.load(std::memory_order_relaxed) < MCTS_MAX_NODES){
+            MoveList moves;
+            generateMoves(current, moves, MoveFilter::NO_LOSING_GIVES);     //Losing gives are never better than the other gives
+            assert(moves.count > 0 && moves.count <= 0xFF);
+            node.moveCount.store(static_cast<uint8_t>(moves.count), std::memory_order_relaxed);
+
+            const uint32_t child = expand(node, current, moves);
+            if (child != MCTS_NO_NODE){
+                makeMove(current, nodes[child].move);
+                path[pathLength++] = child;
+                result = (nodes[child].outcome != MCTS_OPEN) ? nodes[child].outcome : playRandomGame(current, random);
+                break;
+            }
+        }
+
+        const uint32_t next = selectChild(node);
+        if (next == MCTS_NO_NODE){          //The children are still being added by other threads (or the arena is full)
+            result = playRandomGame(current, random);
+            break;
+        }
+        nodes[next].visits.fetch_add(1, std::memory_order_relaxed);        //Virtual loss
+        makeMove(current, nodes[next].move);
+        path[pathLength++] = next;
+        index = next;
+    }
+
+    //Backpropagation (the visits have already been counted on the way down):
+    for (unsigned int n = 0; n < pathLength; ++n){
+        MctsNode& node = nodes[path[n]];
+        if (result == node.mover){
+            node.score.fetch_add(2, std::memory_order_relaxed);
+        }else if (result == MCTS_TIE){
+            node.score.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
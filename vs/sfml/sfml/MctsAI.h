@@ -0,0 +1,122 @@
+#pragma once
+#include <cstdint>
+#include <atomic>
+
+#include "I_AI.h"
+#include "Position.h"
+#include "MoveGenerator.h"
+#include "SearchLimits.h"
+
+
+#define MCTS_DEFAULT_PLAYOUTS 20000     //Playouts per decision, if neither a number of playouts nor a move time is given
+#define MCTS_EXPLORATION 0.7f           //Exploration constant of UCT (higher: unexplored moves are tried more often)
+#define MCTS_MAX_NODES (1 << 20)        //Size of a node arena; the tree isn't expanded any more, if the arena is full (the playouts go on)
+#define MCTS_TIME_CHECK_INTERVAL 256    //The deadline is checked every this many playouts (must be a power of 2)
+#define MCTS_MAX_THREADS 64
+
+#define MCTS_TIE 2                      //Result of a game without a winner (the other results are the colors of the winners)
+#define MCTS_OPEN 0xFF                  //MctsNode::outcome: the game isn't over in the node
+#define MCTS_NO_NODE 0xFFFFFFFF         //Index of a missing node
+
+
+//Fast pseudo random numbers for the playouts (xorshift; rand() is too slow for millions of calls)
+class PlayoutRandom{
+private:
+    uint32_t state;
+public:
+    explicit PlayoutRandom(uint32_t seed) : state(seed != 0 ? seed : 0x9E3779B9){}
+
+    uint32_t next(){
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    unsigned int below(unsigned int n){         //Random number in [0, n)
+        return static_cast<unsigned int>((static_cast<uint64_t>(next()) * n) >> 32);
+    }
+};
+
+
+//Plays the game randomly until the end and returns the result (winning color, or MCTS_TIE)
+//The players win immediately if they can, and don't give the opponent a winning meeple if they can avoid it
+//The position is a copy on the stack --> a playout doesn't allocate any memory
+uint8_t playRandomGame(Position position, PlayoutRandom& random);
+
+
+//Node of the search tree; the nodes live in an arena and reference each other by their index in it, the children of a node are a linked list
+//Several threads work on the tree at the same time: the counters are atomic, and a new child is published with a compare-and-swap of firstChild
+//(all other members of the child are written before, and never change afterwards)
+struct MctsNode{
+    CompoundMove move;                      //The move, which leads from the parent to this node
+    uint8_t mover;                          //Color of the player, who made the move
+    uint8_t outcome;                        //MCTS_OPEN, or the result of the game after the move (winning color, or MCTS_TIE)
+    std::atomic<uint8_t> moveCount;         //Number of moves in the node (0: not generated yet)
+    std::atomic<uint8_t> childCount;        //Number of claimed moves (the children are the first childCount moves of generateMoves(), in any order)
+    std::atomic<uint32_t> visits;           //Counted when a playout passes the node - before its result is known (virtual loss: the other threads see a loss, until the result arrives)
+    std::atomic<uint32_t> score;            //Sum of the results for the mover, in half points (win = 2, tie = 1)
+    std::atomic<uint32_t> firstChild;       //MCTS_NO_NODE, if there is none
+    uint32_t nextSibling;
+};
+
+
+//This AI uses Monte Carlo Tree Search: it builds a tree of compound moves (set the meeple + choose a meeple for the opponent), selects moves
+//with UCT (upper confidence bounds) and evaluates new nodes with random playouts (see playRandomGame())
+//The strength grows with the number of playouts: by default, it plays a fixed number of playouts; with a move time, it plays as many as possible
+//With more than 1 thread, all threads work on the same tree (tree parallelization); the virtual loss spreads them over different paths
+//The tree is kept between the decisions: the subtree of the position, which is reached after the own move and the opponent's move, is the next tree
+//Pondering: during the opponent's turn, the threads search the opponent's position; the next decision keeps the subtree of the opponent's move,
+//  and its playouts count for the budget of the decision (with a move time: the number of playouts, which the last timed decision has reached)
+class MctsAI : public I_AI{
+private:
+    Position expectedPosition;          //The position after setting the meeple in the last selectMeeplePosition() call (the opponent's meeple isn't chosen yet)
+    uint8_t expectedGive;               //The best meeple for the opponent in expectedPosition (found by the same search); NO_MEEPLE if there is none
+    const SearchLimits limits;
+    const unsigned int threadCount;     //Number of search threads (including the calling thread); clamped to 1-MCTS_MAX_THREADS
+    SearchTimer timer;
+    PlayoutRandom random;               //Random numbers of the calling thread (the other threads get their own generators)
+
+    MctsNode* arenas[2];                //The tree is in arenas[activeArena] (the root is node 0); a reused subtree is copied to the other arena
+    unsigned int activeArena;
+    MctsNode* nodes;                    //arenas[activeArena]
+    std::atomic<uint32_t> nodeCount;    //Number of allocated nodes in the active arena
+    bool hasTree;                       //false, if the arena doesn't contain a tree (before the first search)
+    Position rootPosition;              //Position of the root
+
+    unsigned long long maxPlayouts;     //Budget of the current search
+    std::atomic<unsigned long long> startedPlayouts;
+    std::atomic<bool> stopped;          //Set, when the time is up
+    const std::atomic<bool>* ponderStop;    //The caller's flag, which ends the pondering (nullptr, if the AI doesn't ponder)
+    bool pondered;                      //true, if the tree has been built by ponder() since the last decision
+    unsigned long long timedVisits;     //Visits of the root at the end of the last decision, which has used its whole move time (0: none yet)
+    unsigned long long playouts;        //Number of playouts in the last search
+    unsigned int reusedNodes;           //Number of nodes, which have been kept from the last search
+    float bestWinRate;                  //Share of the playouts, which the chosen move has won in the last search
+
+    uint32_t allocateNode();                                                        //Returns MCTS_NO_NODE, if the arena is full
+    uint32_t expand(MctsNode& node, const Position& position, const MoveList& moves);  //Adds the child for the next unclaimed move; returns MCTS_NO_NODE, if there is none
+    uint32_t selectChild(const MctsNode& node) const;                              //Returns the child with the highest UCT value (MCTS_NO_NODE, if there isn't any child yet)
+    void prepareRoot(const Position& position);                                    //Reuses the subtree of the position, or starts a new tree
+    uint32_t findSubtree(const Position& position) const;                          //Searches the position in the first 2 turns of the tree
+    uint32_t copySubtree(uint32_t index, MctsNode* target, uint32_t& targetCount) const;  //Copies the node and its subtree to the target arena; returns the new index
+    void runSearch(const Position& position);                                       //Runs the playouts on all threads within maxPlayouts and the timer; sets playouts
+    void runThread(const Position& position, PlayoutRandom& random, unsigned long long& completed);
+    void runPlayout(const Position& position, PlayoutRandom& random);             //One iteration: selection, expansion, playout, backpropagation
+
+    MctsAI(const MctsAI&);
+    MctsAI& operator = (const MctsAI&);
+public:
+    explicit MctsAI(const SearchLimits& limits = SearchLimits(), unsigned int threadCount = 1);
+    virtual ~MctsAI();
+
+    virtual const Meeple& selectOpponentsMeeple(const GameState& gameState);
+    virtual BoardPos selectMeeplePosition(const GameState& gameState, const Meeple& meepleToSet);
+    virtual void ponder(const Position& position, const std::atomic<bool>& stop);
+
+    CompoundMove searchBestMove(const Position& position);     //Searches all moves of the position, and returns the best one
+    unsigned long long getPlayoutCount() const;                 //Number of playouts of the last decision
+    unsigned int getNodeCount() const;                          //Size of the tree of the last decision
+    unsigned int getReusedNodeCount() const;                    //Number of nodes of the last decision, which have been kept from the decision before
+    float getBestWinRate() const;                               //Share of the playouts, which the move of the last decision has won (a tie counts half)
+};
@@ -2,117 +2,141 @@
 #include <algorithm>
 #include <stdint.h>
 
+#include "Bitboard.h"
+#include "Zobrist.h"
 
-MeepleBag::MeepleBag(MeepleColor::Enum color){       //creates a new bag with 8 brand new meeples
-    meeples.push_back(new Meeple(color, MeepleSize::SMALL, MeepleShape::SQUARE, MeepleDetail::NO_HOLE));
-    meeples.push_back(new Meeple(color, MeepleSize::SMALL, MeepleShape::SQUARE, MeepleDetail::HOLE));
-    meeples.push_back(new Meeple(color, MeepleSize::SMALL, MeepleShape::ROUND, MeepleDetail::NO_HOLE));
-    meeples.push_back(new Meeple(color, MeepleSize::SMALL, MeepleShape::ROUND, MeepleDetail::HOLE));
-    meeples.push_back(new Meeple(color, MeepleSize::BIG, MeepleShape::SQUARE, MeepleDetail::NO_HOLE));
-    meeples.push_back(new Meeple(color, MeepleSize::BIG, MeepleShape::SQUARE, MeepleDetail::HOLE));
-    meeples.push_back(new Meeple(color, MeepleSize::BIG, MeepleShape::ROUND, MeepleDetail::NO_HOLE));
-    meeples.push_back(new Meeple(color, MeepleSize::BIG, MeepleShape::ROUND, MeepleDetail::HOLE));
-    std::random_shuffle(meeples.begin(), meeples.end());
+
+MeepleBag::MeepleBag(MeepleColor::Enum color) : count(8), color(color){       //creates a new bag with 8 brand new meeples
+    Meeple* created[8] = {
+        new Meeple(color, MeepleSize::SMALL, MeepleShape::SQUARE, MeepleDetail::NO_HOLE),
+        new Meeple(color, MeepleSize::SMALL, MeepleShape::SQUARE, MeepleDetail::HOLE),
+        new Meeple(color, MeepleSize::SMALL, MeepleShape::ROUND, MeepleDetail::NO_HOLE),
+        new Meeple(color, MeepleSize::SMALL, MeepleShape::ROUND, MeepleDetail::HOLE),
+        new Meeple(color, MeepleSize::BIG, MeepleShape::SQUARE, MeepleDetail::NO_HOLE),
+        new Meeple(color, MeepleSize::BIG, MeepleShape::SQUARE, MeepleDetail::HOLE),
+        new Meeple(color, MeepleSize::BIG, MeepleShape::ROUND, MeepleDetail::NO_HOLE),
+        new Meeple(color, MeepleSize::BIG, MeepleShape::ROUND, MeepleDetail::HOLE)
+    };
+    available = 0;
+    hash = 0;
+    for (unsigned int i = 0; i < 8; ++i){
+        uint8_t slot = created[i]->getCode() >> 1;
+        meeples[slot] = created[i];
+        order[i] = slot;
+        available |= static_cast<uint16_t>(1 << created[i]->getCode());
+        hash ^= ZOBRIST.inBag[created[i]->getCode()];
+    }
+    std::random_shuffle(order, order + 8);
 }
 
 MeepleBag::~MeepleBag(){
-    for (std::vector<Meeple*>::iterator it = meeples.begin(); it != meeples.end(); ++it){
-        delete *(it);
-    }
-    for (std::vector<Meeple*>::iterator it = usedMeeples.begin(); it != usedMeeples.end(); ++it){
-        delete *(it);
+    for (unsigned int slot = 0; slot < 8; ++slot){
+        delete meeples[slot];
     }
 } 
 
 Meeple* MeepleBag::getUsedMeepleRepresentation(const Meeple& original) const{
-    for (std::vector<Meeple*>::const_iterator it = usedMeeples.begin(); it != usedMeeples.end(); ++it){
-        if (**it == original){
-            return *it;
-        }
+    if (original.getColor() != color || (available & (1 << original.getCode())) != 0){
+        return nullptr;
     }
-    return nullptr;
+    return meeples[original.getCode() >> 1];
 }
  
-MeepleBag::MeepleBag(const MeepleBag& base){
-    for (std::vector<Meeple*>::const_iterator it = base.meeples.begin(); it != base.meeples.end(); ++it){
-        meeples.push_back(new Meeple(**it));
-    }
-    for (std::vector<Meeple*>::const_iterator it = base.usedMeeples.begin(); it != base.usedMeeples.end(); ++it){
-        usedMeeples.push_back(new Meeple(**it));
+MeepleBag::MeepleBag(const MeepleBag& base) : count(base.count), available(base.available), color(base.color), hash(base.hash){
+    for (unsigned int slot = 0; slot < 8; ++slot){
+        meeples[slot] = new Meeple(*base.meeples[slot]);
+        order[slot] = base.order[slot];
     }
 }
 
 
 
 void MeepleBag::reset(){
-    meeples.insert(meeples.end(), usedMeeples.begin(), usedMeeples.end());
-    usedMeeples.clear();
-    std::random_shuffle(meeples.begin(), meeples.end());
-    assert(meeples.size() == 8); 
+    count = 8;
+    available = MEEPLE_PROPERTY_MASKS[getPropertyPlaneIndex(MeepleProperty::MEEPLE_COLOR, color)];
+    hash = calculateHash();
+    std::random_shuffle(order, order + 8);
 }
 
 const Meeple* MeepleBag::getMeeple(unsigned int index) const{
-    return meeples.at(index);
+    assert(index < count);
+    return meeples[order[index]];
 }
 
 unsigned int MeepleBag::getMeepleCount() const{
-    return meeples.size();
+    return count;
 }
 
-Meeple* MeepleBag::removeMeeple(const Meeple& meeple){
-    for (std::vector<Meeple*>::iterator it = meeples.begin(); it != meeples.end(); ++it){
-        if (meeple == **it){           
-            Meeple* m = *it;
-            meeples.erase(it);
-            usedMeeples.push_back(m);
-            return m;
-        }
+unsigned int MeepleBag::getSlotIndex(uint8_t slot) const{
+    unsigned int index = 0;
+    while (order[index] != slot){
+        ++index;
     }
-    assert(false);
-    return nullptr;
+    assert(index < 8);
+    return index;
 }
 
-Meeple* MeepleBag::removeMeeple(unsigned int index){
-    std::vector<Meeple*>::iterator it = meeples.begin() + index;
-    Meeple* m = *it;
-    meeples.erase(it);
-    usedMeeples.push_back(m);
+Meeple* MeepleBag::removeMeepleAt(unsigned int index){
+    assert(index < count);
+    Meeple* m = meeples[order[index]];
+    std::rotate(order + index, order + index + 1, order + 8);      //the slot becomes the last used meeple
+    --count;
+    available &= static_cast<uint16_t>(~(1 << m->getCode()));
+    hash ^= ZOBRIST.inBag[m->getCode()];
+    assert(hash == calculateHash());
     return m;
 }
 
+Meeple* MeepleBag::removeMeeple(const Meeple& meeple){
+    assert(isMeepleInBag(meeple));
+    return removeMeepleAt(getSlotIndex(meeple.getCode() >> 1));
+}
+
+Meeple* MeepleBag::removeMeeple(unsigned int index){
+    return removeMeepleAt(index);
+}
+
+void MeepleBag::undoRemoveMeeple(Meeple& meeple, unsigned int index){
+    assert(count < 8 && meeples[order[7]] == &meeple);         //only the last removed meeple can be put back
+    assert(index <= count);
+    std::rotate(order + index, order + 7, order + 8);
+    ++count;
+    available |= static_cast<uint16_t>(1 << meeple.getCode());
+    hash ^= ZOBRIST.inBag[meeple.getCode()];
+    assert(hash == calculateHash());
+}
+
 bool MeepleBag::isMeepleInBag(const Meeple& meeple) const{
-    for (std::vector<Meeple*>::const_iterator it = meeples.begin(); it != meeples.end(); ++it){
-        if (meeple == **it){
-            return true;
-        }
-    }
-    return false;
+    return (available & (1 << meeple.getCode())) != 0;
 }
 
 int MeepleBag::getMeepleIndex(const Meeple& meeple) const{
-    unsigned int index = 0;
-    for (std::vector<Meeple*>::const_iterator it = meeples.begin(); it != meeples.end(); ++it, ++index){
-        if (meeple == **it){
-            return index;
-        }
+    if (!isMeepleInBag(meeple)){
+        return -1;
     }
-    return -1;
+    return getSlotIndex(meeple.getCode() >> 1);
 }
 
 unsigned int MeepleBag::getSimilarMeepleCount(MeepleProperty prop) const{
-    unsigned int count = 0;
-    for (std::vector<Meeple*>::const_iterator it = meeples.begin(); it != meeples.end(); ++it){
-        if ((*it)->hasSameProperty(prop)){
-            count++;
-        }
-    }
-    return count;
+    return popcount16(available & MEEPLE_PROPERTY_MASKS[getPropertyPlaneIndex(prop.type, prop.getValue())]);
 }
 
 MeepleColor::Enum MeepleBag::getBagColor() const{
-    std::vector<Meeple*>::const_iterator it = meeples.begin();
-    if (it != meeples.end()){
-        return (*it)->getColor();
+    return color;
+}
+
+uint16_t MeepleBag::getAvailableMeeples() const{
+    return available;
+}
+
+uint64_t MeepleBag::getHash() const{
+    return hash;
+}
+
+uint64_t MeepleBag::calculateHash() const{
+    uint64_t h = 0;
+    for (uint16_t codes = available; codes != 0; codes &= codes - 1){
+        h ^= ZOBRIST.inBag[lowestBitIndex(codes)];
     }
-    return (*usedMeeples.begin())->getColor();
-}
\ No newline at end of file
+    return h;
+}
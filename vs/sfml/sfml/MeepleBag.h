@@ -1,6 +1,6 @@
 #pragma once
 
-#include <vector>
+#include <cstdint>
 
 #include "helper.h"
 #include "meeple.h"
@@ -12,8 +12,17 @@
 class MeepleBag
 {
 private:
-    std::vector<Meeple*> usedMeeples;
-    std::vector<Meeple*> meeples;
+    //Each meeple of the bag has a fixed slot (slot = code >> 1, since bit 0 of the code is the color)
+    Meeple* meeples[8];                                     //Index: slot; the meeples are owned by the bag (even if they are on the board)
+    uint8_t order[8];                                       //Slots of the meeples: [0, count) = meeples in the bag (in the order of the index-API); [count, 8) = removed meeples (in the order of removal, the last removed meeple is at the end)
+    uint8_t count;                                          //Number of meeples in the bag
+    uint16_t available;                                     //Bit c is set, if the meeple with the code c is in the bag (see MEEPLE_PROPERTY_MASKS)
+    MeepleColor::Enum color;                                //The color of all meeples in the bag
+    uint64_t hash;                                          //XOR of the Zobrist-keys of all meeples in the bag (see ZOBRIST.inBag)
+
+    uint64_t calculateHash() const;                         //Calculates the hash from scratch (for assertions only)
+    unsigned int getSlotIndex(uint8_t slot) const;          //Returns the position of the slot in order[]
+    Meeple* removeMeepleAt(unsigned int index);             //Removes the meeple at the position index of the index-API
 public:
     explicit MeepleBag(MeepleColor::Enum color);            //creates a new bag with 8 brand new meeples
     explicit MeepleBag(const MeepleBag& base);              //Generates a new copy of this bag
@@ -31,10 +40,13 @@ public:
             
     Meeple* removeMeeple(const Meeple& meeple);             //removes the meeple from the bag
     Meeple* removeMeeple(unsigned int index);               //removes the meeple from the bag
+    void undoRemoveMeeple(Meeple& meeple, unsigned int index);  //Puts the meeple, which has been removed last, back to its old index (doesn't allocate memory)
     
     bool isMeepleInBag(const Meeple& meeple) const;         //returns, if this meeple is in the bag
     int getMeepleIndex(const Meeple& meeple) const;         //returns the index of the meeple in the bag; returns -1, if the meeple is not in the bag
 
     MeepleColor::Enum getBagColor() const;                  //returns the color of the meeples within the bag
+    uint16_t getAvailableMeeples() const;                   //Returns a mask over the meeple codes: bit c is set, if the meeple with the code c is in the bag
+    uint64_t getHash() const;                               //Zobrist-hash of the meeples in the bag
 };
 
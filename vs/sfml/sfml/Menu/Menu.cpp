@@ -117,10 +117,10 @@ void FourWins::Menu::MainMenu::init(ResourceManager &resourceManager, SoundManag
 		setValueForEntry(4u, 'm').
 		setStringForEntry(5u, "Newton AI").
 		setValueForEntry(5u, 'm').//TODO neu mappen
-		setStringForEntry(6u, "Networking AI").
-		setValueForEntry(6u, 'm').//TODO neu mappen
-		setStringForEntry(7u, "??? AI").
-		setValueForEntry(7u, 'x').
+		setStringForEntry(6u, "MCTS AI").
+		setValueForEntry(6u, 'c').
+		setStringForEntry(7u, "Solver AI").
+		setValueForEntry(7u, 'v').
 		setDefaultEntry(0);
 
 	this->lbPlayer2->init();
@@ -141,10 +141,10 @@ void FourWins::Menu::MainMenu::init(ResourceManager &resourceManager, SoundManag
 		setValueForEntry(4u, 'm').
 		setStringForEntry(5u, "Newton AI").
 		setValueForEntry(5u, 'm').//TODO neu mappen
-		setStringForEntry(6u, "Networking AI").
-		setValueForEntry(6u, 'm').//TODO neu mappen
-		setStringForEntry(7u, "??? AI").
-		setValueForEntry(7u, 'x').
+		setStringForEntry(6u, "MCTS AI").
+		setValueForEntry(6u, 'c').
+		setStringForEntry(7u, "Solver AI").
+		setValueForEntry(7u, 'v').
 		setDefaultEntry(0);
 
 	this->cbMeepleChoose->init();
@@ -481,6 +481,12 @@ GameSettings *FourWins::Menu::MainMenu::createSettings()
     case 'm':
         player1Type = GameSettings::SMART_AI;
         break;
+    case 'v':
+        player1Type = GameSettings::SOLVER_AI;
+        break;
+    case 'c':
+        player1Type = GameSettings::MCTS_AI;
+        break;
     default:
         player1Type = GameSettings::HUMAN;
         break;
@@ -502,6 +508,12 @@ GameSettings *FourWins::Menu::MainMenu::createSettings()
     case 'm':
         player2Type = GameSettings::SMART_AI;
         break;
+    case 'v':
+        player2Type = GameSettings::SOLVER_AI;
+        break;
+    case 'c':
+        player2Type = GameSettings::MCTS_AI;
+        break;
     default:
         player2Type = GameSettings::HUMAN;
         break;
@@ -0,0 +1,201 @@
+#include "MoveGenerator.h"
+
+#include <assert.h>
+
+#include "Meeple.h"
+#include "Zobrist.h"
+
+
+
+//Planes of the position (see Board::getPropertyPlane())
+static void buildPlanes(const Position& position, uint16_t planes[PROPERTY_PLANE_COUNT]){
+    for (uint8_t p = 0; p < PROPERTY_PLANE_COUNT; ++p){
+        planes[p] = 0;
+    }
+    for (uint16_t fields = position.occupied; fields != 0; fields &= fields - 1){
+        uint8_t field = lowestBitIndex(fields);
+        uint8_t code = position.getMeepleCode(field);
+        for (uint8_t p = 0; p < PROPERTY_COUNT; ++p){
+            planes[getPropertyPlaneIndex(p, (code >> p) & 1)] |= static_cast<uint16_t>(1 << field);
+        }
+    }
+}
+
+//Mask over the meeple codes, which complete the line (the line must contain exactly 3 meeples): all codes, which share a property-value with the 3 meeples
+static uint16_t getCompletingCodes(const uint16_t planes[PROPERTY_PLANE_COUNT], uint16_t lineFields){
+    uint16_t codes = 0;
+    for (uint8_t p = 0; p < PROPERTY_PLANE_COUNT; ++p){
+        if ((planes[p] & lineFields) == lineFields){
+            codes |= MEEPLE_PROPERTY_MASKS[p];
+        }
+    }
+    return codes;
+}
+
+//Mask over the meeple codes, which win on any empty field
+static uint16_t getWinningCodes(const uint16_t planes[PROPERTY_PLANE_COUNT], uint16_t occupied){
+    uint16_t codes = 0;
+    for (uint8_t line = 0; line < WIN_LINE_COUNT; ++line){
+        uint16_t lineFields = occupied & WIN_LINE_MASKS[line];
+        if (popcount16(lineFields) == 3){
+            codes |= getCompletingCodes(planes, lineFields);
+        }
+    }
+    return codes;
+}
+
+
+
+bool isWinningField(const Position& position, uint8_t field, uint8_t code){
+    assert(position.isFieldEmpty(field) && code < 16);
+    uint16_t planes[PROPERTY_PLANE_COUNT];
+    buildPlanes(position, planes);
+    for (uint16_t lines = FIELD_LINES[field]; lines != 0; lines &= lines - 1){
+        uint16_t lineFields = position.occupied & WIN_LINE_MASKS[lowestBitIndex(lines)];
+        if (popcount16(lineFields) == 3 && (getCompletingCodes(planes, lineFields) & (1 << code)) != 0){
+            return true;
+        }
+    }
+    return false;
+}
+
+uint16_t getWinningCodes(const Position& position){
+    uint16_t planes[PROPERTY_PLANE_COUNT];
+    buildPlanes(position, planes);
+    return getWinningCodes(planes, position.occupied);
+}
+
+
+void generateMoves(const Position& position, MoveList& moves, unsigned int filter){
+    moves.count = 0;
+    const uint8_t opponent = static_cast<uint8_t>(position.sideToMove ^ 1);
+    const uint16_t opponentCodes = position.available & MEEPLE_PROPERTY_MASKS[getPropertyPlaneIndex(MeepleProperty::MEEPLE_COLOR, opponent)];     //The player chooses from the opponent's bag
+
+    uint16_t planes[PROPERTY_PLANE_COUNT];
+    buildPlanes(position, planes);
+
+    if (position.meepleToSet == NO_MEEPLE){         //Only choose a meeple
+        if (filter & MoveFilter::WINS_ONLY){
+            return;
+        }
+        uint16_t gives = opponentCodes;
+        if ((filter & MoveFilter::NO_LOSING_GIVES) && (gives & ~getWinningCodes(planes, position.occupied)) != 0){
+            gives &= static_cast<uint16_t>(~getWinningCodes(planes, position.occupied));
+        }
+        for (; gives != 0; gives &= gives - 1){
+            CompoundMove move = { NO_FIELD, lowestBitIndex(gives) };
+            moves.moves[moves.count++] = move;
+        }
+        return;
+    }
+
+    //The lines with 3 meeples are threats for the opponent; only the lines through the new field change:
+    uint16_t completing[WIN_LINE_COUNT];
+    for (uint8_t line = 0; line < WIN_LINE_COUNT; ++line){
+        uint16_t lineFields = position.occupied & WIN_LINE_MASKS[line];
+        completing[line] = (popcount16(lineFields) == 3) ? getCompletingCodes(planes, lineFields) : 0;
+    }
+
+    const uint8_t code = position.meepleToSet;
+    for (uint16_t empty = static_cast<uint16_t>(~position.occupied); empty != 0; empty &= empty - 1){
+        const uint8_t field = lowestBitIndex(empty);
+        const uint16_t bit = static_cast<uint16_t>(1 << field);
+
+        //Does the meeple win on this field?
+        bool wins = false;
+        for (uint16_t lines = FIELD_LINES[field]; lines != 0 && !wins; lines &= lines - 1){
+            wins = (completing[lowestBitIndex(lines)] & (1 << code)) != 0;
+        }
+        if (wins || popcount16(position.occupied) == FIELD_COUNT - 1 || opponentCodes == 0){     //The game is over (or the opponent has nothing left to set)
+            if (wins || !(filter & MoveFilter::WINS_ONLY)){
+                CompoundMove move = { field, NO_MEEPLE };
+                moves.moves[moves.count++] = move;
+            }
+            continue;
+        }
+        if (filter & MoveFilter::WINS_ONLY){
+            continue;
+        }
+
+        uint16_t gives = opponentCodes;
+        if (filter & MoveFilter::NO_LOSING_GIVES){
+            uint16_t newPlanes[PROPERTY_PLANE_COUNT];
+            for (uint8_t p = 0; p < PROPERTY_COUNT; ++p){
+                uint8_t value = (code >> p) & 1;
+                newPlanes[getPropertyPlaneIndex(p, value)] = planes[getPropertyPlaneIndex(p, value)] | bit;
+                newPlanes[getPropertyPlaneIndex(p, value ^ 1)] = planes[getPropertyPlaneIndex(p, value ^ 1)];
+            }
+            uint16_t losing = 0;
+            const uint16_t occupied = position.occupied | bit;
+            for (uint8_t line = 0; line < WIN_LINE_COUNT; ++line){
+                if ((WIN_LINE_MASKS[line] & bit) == 0){
+                    losing |= completing[line];                 //unchanged line
+                }else if (popcount16(occupied & WIN_LINE_MASKS[line]) == 3){
+                    losing |= getCompletingCodes(newPlanes, occupied & WIN_LINE_MASKS[line]);     //a new threat
+                }
+            }
+            if ((gives & ~losing) != 0){
+                gives &= static_cast<uint16_t>(~losing);
+            }
+        }
+        for (; gives != 0; gives &= gives - 1){
+            CompoundMove move = { field, lowestBitIndex(gives) };
+            moves.moves[moves.count++] = move;
+        }
+    }
+    assert(moves.count <= MAX_COMPOUND_MOVES);
+}
+
+
+Position playMove(const Position& position, const CompoundMove& move){
+    Position result = position;
+    if (move.field != NO_FIELD){
+        assert(position.meepleToSet != NO_MEEPLE);
+        result.setMeeple(move.field, position.meepleToSet);
+    }
+    result.meepleToSet = move.give;
+    if (move.give != NO_MEEPLE){
+        assert(position.available & (1 << move.give));
+        result.available &= static_cast<uint16_t>(~(1 << move.give));
+    }
+    result.sideToMove = static_cast<uint8_t>(result.sideToMove ^ 1);
+    return result;
+}
+
+void makeMove(Position& position, const CompoundMove& move){
+    if (move.field != NO_FIELD){
+        assert(position.meepleToSet != NO_MEEPLE);
+        position.setMeeple(move.field, position.meepleToSet);
+    }
+    position.meepleToSet = move.give;
+    if (move.give != NO_MEEPLE){
+        assert(position.available & (1 << move.give));
+        position.available &= static_cast<uint16_t>(~(1 << move.give));
+    }
+    position.sideToMove = static_cast<uint8_t>(position.sideToMove ^ 1);
+}
+
+void unmakeMove(Position& position, const CompoundMove& move){
+    position.sideToMove = static_cast<uint8_t>(position.sideToMove ^ 1);
+    if (move.give != NO_MEEPLE){
+        position.available |= static_cast<uint16_t>(1 << move.give);
+    }
+    if (move.field != NO_FIELD){
+        uint8_t code = position.getMeepleCode(move.field);
+        position.removeMeeple(move.field);
+        position.available &= static_cast<uint16_t>(~(1 << code));     //The meeple is the meepleToSet again, not back in a bag
+        position.meepleToSet = code;
+    }else{
+        position.meepleToSet = NO_MEEPLE;
+    }
+}
+
+uint64_t getHashAfterMove(uint64_t hash, const Position& position, const CompoundMove& move){
+    if (move.field != NO_FIELD){
+        hash ^= ZOBRIST.meepleToSet[position.meepleToSet] ^ ZOBRIST.field[move.field][position.meepleToSet];
+    }
+    if (move.give != NO_MEEPLE){
+        hash ^= ZOBRIST.inBag[move.give] ^ ZOBRIST.meepleToSet[move.give];
+    }
+    return hash ^ ZOBRIST.blackToMove;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+
+#include "Bitboard.h"
+#include "Position.h"
+
+
+//Move generation on Positions for searching AIs (no allocations: the moves are written to a fixed-size MoveList, which can live on the stack)
+//A compound move is one turn of a player: set the meepleToSet to a field, then choose the meeple, which the opponent has to set next
+
+
+#define NO_FIELD 0xFF                           //CompoundMove::field: nothing is set (first turn of the game: the player only chooses a meeple for the opponent)
+#define MAX_COMPOUND_MOVES (FIELD_COUNT * 8)    //max. 16 empty fields * 8 meeples in the opponent's bag (a player can only choose meeples of the opponent's color)
+
+
+struct CompoundMove{
+    uint8_t field;              //Field for the meepleToSet; NO_FIELD, if there is no meepleToSet
+    uint8_t give;               //Code of the meeple for the opponent; NO_MEEPLE, if the game is over after setting the meeple (win, or full board)
+};
+
+struct MoveList{
+    CompoundMove moves[MAX_COMPOUND_MOVES];
+    unsigned int count;
+};
+
+struct MoveFilter{
+    enum Enum{
+        ALL = 0,
+        WINS_ONLY = 1,          //Only moves, which win immediately
+        NO_LOSING_GIVES = 2     //Skips meeples, which the opponent could use to win immediately (if every meeple loses, all of them are kept)
+    };
+};
+
+
+void generateMoves(const Position& position, MoveList& moves, unsigned int filter = MoveFilter::ALL);   //Writes all legal moves of position.sideToMove to moves (a move, which wins or fills the board, has no give)
+Position playMove(const Position& position, const CompoundMove& move);                                  //Returns the position after the move (sideToMove is the opponent)
+
+//In-place variant of playMove() for searches, which keep a single Position:
+    void makeMove(Position& position, const CompoundMove& move);        //Changes the position to the position after the move
+    void unmakeMove(Position& position, const CompoundMove& move);      //Reverts makeMove(); the move must be the last move made on the position
+
+uint64_t getHashAfterMove(uint64_t hash, const Position& position, const CompoundMove& move);    //Updates the Zobrist-hash of the position (see Position::getHash()) incrementally to the hash of playMove(position, move)
+
+bool isWinningField(const Position& position, uint8_t field, uint8_t code);     //true, if setting the meeple with the code to the (empty) field creates 4 similar meeples in a row/col/diagonal
+uint16_t getWinningCodes(const Position& position);                             //Mask over the meeple codes: bit c is set, if the meeple with the code c can win on any empty field
@@ -0,0 +1,156 @@
+#include "OpeningBook.h"
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+#include <unordered_set>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <string.h>
+#include <assert.h>
+
+#include "Symmetry.h"
+#include "MctsAI.h"
+
+
+
+static OpeningBook globalOpeningBook;
+
+OpeningBook& OpeningBook::getGlobal(){
+    return globalOpeningBook;
+}
+
+
+OpeningBook::OpeningBook() : header(nullptr), entries(nullptr){
+}
+
+bool OpeningBook::load(const std::string& path){
+    unload();
+    if (!file.open(path)){
+        return false;
+    }
+    const OpeningBookHeader* fileHeader = reinterpret_cast<const OpeningBookHeader*>(file.getData());
+    if (file.getSize() < sizeof(OpeningBookHeader) || memcmp(fileHeader->magic, "4WOB", 4) != 0 || fileHeader->version != OPENING_BOOK_VERSION
+        || file.getSize() != sizeof(OpeningBookHeader) + fileHeader->entryCount * sizeof(OpeningBookEntry)){
+        std::cout << "The opening book " << path << " is invalid, it is ignored" << std::endl;
+        file.close();
+        return false;
+    }
+    header = fileHeader;
+    entries = reinterpret_cast<const OpeningBookEntry*>(file.getData() + sizeof(OpeningBookHeader));
+    return true;
+}
+
+void OpeningBook::unload(){
+    file.close();
+    header = nullptr;
+    entries = nullptr;
+}
+
+bool OpeningBook::isLoaded() const{
+    return header != nullptr;
+}
+
+uint64_t OpeningBook::getEntryCount() const{
+    return isLoaded() ? header->entryCount : 0;
+}
+
+
+const OpeningBookEntry* OpeningBook::find(uint64_t key) const{
+    assert(isLoaded());
+    uint64_t low = 0;
+    uint64_t high = header->entryCount;       //The key is in [low, high)
+    while (low < high){
+        const uint64_t middle = low + (high - low) / 2;
+        if (entries[middle].key < key){
+            low = middle + 1;
+        }else{
+            high = middle;
+        }
+    }
+    return (low < header->entryCount && entries[low].key == key) ? &entries[low] : nullptr;
+}
+
+bool OpeningBook::probe(const Position& position, CompoundMove& move) const{
+    if (!isLoaded() || popcount16(position.occupied) + 1u > header->plies){     //Ply p (counted from 0) has p - 1 meeples on the board (the first 2 plies have none)
+        return false;
+    }
+    Position canonical;
+    SymmetryTransform transform = canonicalize(position, canonical);
+    const OpeningBookEntry* entry = find(canonical.getHash());
+    if (entry == nullptr){
+        return false;
+    }
+    move.field = (entry->field != NO_FIELD) ? transform.unmapField(entry->field) : static_cast<uint8_t>(NO_FIELD);
+    move.give = (entry->give != NO_MEEPLE) ? transform.unmapCode(entry->give) : static_cast<uint8_t>(NO_MEEPLE);
+    return true;
+}
+
+
+
+static bool compareEntries(const OpeningBookEntry& lhs, const OpeningBookEntry& rhs){
+    return lhs.key < rhs.key;
+}
+
+bool generateOpeningBook(unsigned int plies, unsigned int playouts, const std::string& path){
+    assert(plies >= 1 && plies <= OPENING_BOOK_MAX_PLIES);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "Searching all positions of the first " << plies << " plies with " << playouts << " playouts (" << threads << " threads)..." << std::endl;
+
+    std::vector<OpeningBookEntry> entries;
+    std::vector<Position> level(1, Position::empty());          //The canonical positions of the current ply
+    std::unordered_set<uint64_t> known;
+    for (unsigned int ply = 0; ply < plies; ++ply){
+        std::vector<Position> nextLevel;
+        for (std::vector<Position>::const_iterator it = level.begin(); it != level.end(); ++it){
+            MctsAI mcts(SearchLimits(0, 0, playouts), threads);        //A new AI per position: the tree of another position is useless
+            CompoundMove best = mcts.searchBestMove(*it);
+
+            OpeningBookEntry entry;
+            memset(&entry, 0, sizeof(entry));
+            entry.key = it->getHash();
+            entry.field = best.field;
+            entry.give = best.give;
+            entry.winRate = static_cast<uint16_t>(mcts.getBestWinRate() * 1000 + 0.5f);
+            entry.playouts = static_cast<uint32_t>(mcts.getPlayoutCount());
+            entries.push_back(entry);
+
+            //All positions of the next ply (losing meeples are skipped - no AI gives them away that early):
+            if (ply + 1 < plies){
+                MoveList moves;
+                generateMoves(*it, moves, MoveFilter::NO_LOSING_GIVES);
+                for (unsigned int m = 0; m < moves.count; ++m){
+                    Position canonical;
+                    canonicalize(playMove(*it, moves.moves[m]), canonical);
+                    if (known.insert(canonical.getHash()).second){
+                        nextLevel.push_back(canonical);
+                    }
+                }
+            }
+        }
+        std::cout << "  ply " << ply + 1 << ": " << level.size() << " positions (" << std::fixed << std::setprecision(1)
+            << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << " s)" << std::endl;
+        level.swap(nextLevel);
+    }
+
+    std::sort(entries.begin(), entries.end(), compareEntries);
+    OpeningBookHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "4WOB", 4);
+    header.version = OPENING_BOOK_VERSION;
+    header.plies = plies;
+    header.entryCount = entries.size();
+
+    std::ofstream output(path.c_str(), std::ios::binary | std::ios::trunc);
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(reinterpret_cast<const char*>(&entries[0]), entries.size() * sizeof(OpeningBookEntry));
+    if (!output){
+        std::cout << "Couldn't write " << path << std::endl;
+        return false;
+    }
+    std::cout << "Wrote " << entries.size() << " positions (" << (sizeof(header) + entries.size() * sizeof(OpeningBookEntry)) / 1024 << " KB) to " << path << std::endl;
+    return true;
+}
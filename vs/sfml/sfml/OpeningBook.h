@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+#include "Position.h"
+#include "MoveGenerator.h"
+#include "MappedFile.h"
+#include "config.h"
+
+
+//Opening book: best moves for the first turns of a game, found by a deep offline search (MctsAI with many playouts)
+//The positions are stored in their canonical form (see canonicalize()), keyed by the Zobrist-hash of the canonical position
+//The file is an array of entries sorted by the key, which is memory-mapped at startup; a probe is a binary search in the mapping
+//The book contains every position of the first plies (all moves of both players), so the AIs don't search until the first position outside of it
+
+
+#define OPENING_BOOK_FILE WORKING_DIR "opening.book"   //Loaded at startup, if it exists
+#define OPENING_BOOK_MAX_PLIES 4                        //4 plies have ~200 canonical positions, each further ply multiplies them by ~100
+#define OPENING_BOOK_DEFAULT_PLAYOUTS 100000            //Playouts of the MctsAI per book position
+#define OPENING_BOOK_VERSION 1
+
+
+struct OpeningBookEntry{
+    uint64_t key;               //Zobrist-hash of the canonical position
+    uint8_t field;              //Best move in the canonical position (NO_FIELD, if only a meeple has to be chosen)
+    uint8_t give;
+    uint16_t winRate;           //Share of the playouts, which the move has won (per mille; a tie counts half)
+    uint32_t playouts;          //Playouts of the search
+};
+
+struct OpeningBookHeader{
+    char magic[4];              //"4WOB"
+    uint32_t version;
+    uint32_t plies;             //The book contains all positions of the first plies (compound moves)
+    uint32_t reserved;
+    uint64_t entryCount;
+};
+
+
+class OpeningBook{
+private:
+    MappedFile file;
+    const OpeningBookHeader* header;
+    const OpeningBookEntry* entries;
+
+    OpeningBook(const OpeningBook&);
+    OpeningBook& operator = (const OpeningBook&);
+public:
+    OpeningBook();
+
+    static OpeningBook& getGlobal();                        //The book, which is used by the AIs (see OPENING_BOOK_FILE)
+
+    bool load(const std::string& path);                     //Maps the file; returns false, if it doesn't exist or is invalid
+    void unload();
+    bool isLoaded() const;
+    uint64_t getEntryCount() const;
+
+    const OpeningBookEntry* find(uint64_t key) const;       //Binary search for the key; nullptr, if it isn't in the book
+    bool probe(const Position& position, CompoundMove& move) const;     //Looks up the book move of the position; returns false, if the position isn't in the book
+};
+
+
+//Searches all positions of the first plies with the MctsAI (playouts per position), and writes the book to the file; prints the progress to the console
+bool generateOpeningBook(unsigned int plies, unsigned int playouts, const std::string& path);
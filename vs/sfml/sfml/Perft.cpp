@@ -0,0 +1,152 @@
+#include "Perft.h"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdint>
+#include <assert.h>
+
+#include "Position.h"
+#include "MoveGenerator.h"
+#include "GameState.h"
+#include "MeepleBag.h"
+#include "Meeple.h"
+#include "Board.h"
+
+
+
+struct PerftCounters{           //Index: depth
+    uint64_t nodes[MAX_PERFT_DEPTH + 1];
+    uint64_t wins[MAX_PERFT_DEPTH + 1];
+    uint64_t ties[MAX_PERFT_DEPTH + 1];
+
+    PerftCounters(){
+        for (unsigned int d = 0; d <= MAX_PERFT_DEPTH; ++d){
+            nodes[d] = wins[d] = ties[d] = 0;
+        }
+    }
+    uint64_t getTotalNodes() const{
+        uint64_t total = 0;
+        for (unsigned int d = 0; d <= MAX_PERFT_DEPTH; ++d){
+            total += nodes[d];
+        }
+        return total;
+    }
+};
+
+
+static void perftPosition(const Position& position, unsigned int depth, unsigned int maxDepth, PerftCounters& counters){
+    MoveList moves;
+    generateMoves(position, moves);
+    ++depth;
+    counters.nodes[depth] += moves.count;
+    for (unsigned int m = 0; m < moves.count; ++m){
+        const CompoundMove& move = moves.moves[m];
+        if (move.give == NO_MEEPLE){        //Game over
+            if (playMove(position, move).checkWinSituation()){
+                ++counters.wins[depth];
+            }else{
+                ++counters.ties[depth];
+            }
+        }else if (depth < maxDepth){
+            perftPosition(playMove(position, move), depth, maxDepth, counters);
+        }
+    }
+}
+
+
+static void perftGameState(GameState& gameState, const Meeple* meepleToSet, MeepleColor::Enum sideToMove, unsigned int depth, unsigned int maxDepth, PerftCounters& counters){
+    MeepleBag* giveBag = (gameState.ownBag->getBagColor() != sideToMove) ? gameState.ownBag : gameState.opponentBag;     //The player chooses from the opponent's bag
+    MeepleColor::Enum opponent = (sideToMove == MeepleColor::WHITE) ? MeepleColor::BLACK : MeepleColor::WHITE;
+    ++depth;
+
+    if (meepleToSet == nullptr){            //Only choose a meeple
+        for (unsigned int i = 0; i < giveBag->getMeepleCount(); ++i){
+            ++counters.nodes[depth];
+            if (depth < maxDepth){
+                perftGameState(gameState, giveBag->getMeeple(i), opponent, depth, maxDepth, counters);
+            }
+        }
+        return;
+    }
+
+    for (uint8_t f = 0; f < FIELD_COUNT; ++f){
+        BoardPos position = BoardPos::fromFieldIndex(f);
+        if (!gameState.board->isFieldEmpty(position)){
+            continue;
+        }
+        gameState.play(position, *meepleToSet);
+        if (gameState.board->checkWinSituation() != nullptr){
+            ++counters.nodes[depth];
+            ++counters.wins[depth];
+        }else if (gameState.board->isFull() || giveBag->getMeepleCount() == 0){
+            ++counters.nodes[depth];
+            ++counters.ties[depth];
+        }else{
+            for (unsigned int i = 0; i < giveBag->getMeepleCount(); ++i){
+                ++counters.nodes[depth];
+                if (depth < maxDepth){
+                    perftGameState(gameState, giveBag->getMeeple(i), opponent, depth, maxDepth, counters);
+                }
+            }
+        }
+        gameState.undo();
+    }
+}
+
+
+bool runPerft(unsigned int depth, const std::string& positionText){
+    assert(depth >= 1 && depth <= MAX_PERFT_DEPTH);
+    Position position = Position::empty();
+    if (!positionText.empty() && !Position::fromString(positionText, position)){
+        std::cout << "Invalid position \"" << positionText << "\"" << std::endl;
+        return false;
+    }
+    if (position.checkWinSituation() || position.isFull()){
+        std::cout << "The game is already over in the position \"" << positionText << "\"" << std::endl;
+        return false;
+    }
+    std::cout << "Perft " << depth << " from " << position.toString() << std::endl;
+
+    //Walk 1: Position + generateMoves()
+    PerftCounters positionCounters;
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    perftPosition(position, 0, depth, positionCounters);
+    double positionSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+    //Walk 2: GameState + Board + MeepleBag
+    MeepleBag white(MeepleColor::WHITE);
+    MeepleBag black(MeepleColor::BLACK);
+    Board board;
+    GameState gameState(&white, &black, &board);
+    position.applyTo(gameState);
+    const Meeple* meepleToSet = nullptr;
+    if (position.meepleToSet != NO_MEEPLE){
+        MeepleBag& bag = ((position.meepleToSet & 1) == MeepleColor::WHITE) ? white : black;
+        meepleToSet = bag.getMeeple(bag.getMeepleIndex(Meeple(position.meepleToSet)));
+    }
+    PerftCounters gameStateCounters;
+    start = std::chrono::high_resolution_clock::now();
+    perftGameState(gameState, meepleToSet, static_cast<MeepleColor::Enum>(position.sideToMove), 0, depth, gameStateCounters);
+    double gameStateSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+    bool equal = true;
+    std::cout << std::setw(6) << "depth" << std::setw(16) << "nodes" << std::setw(14) << "wins" << std::setw(14) << "ties" << std::endl;
+    for (unsigned int d = 1; d <= depth; ++d){
+        std::cout << std::setw(6) << d << std::setw(16) << positionCounters.nodes[d] << std::setw(14) << positionCounters.wins[d] << std::setw(14) << positionCounters.ties[d];
+        if (positionCounters.nodes[d] != gameStateCounters.nodes[d] || positionCounters.wins[d] != gameStateCounters.wins[d] || positionCounters.ties[d] != gameStateCounters.ties[d]){
+            std::cout << "   MISMATCH: GameState walk found " << gameStateCounters.nodes[d] << " / " << gameStateCounters.wins[d] << " / " << gameStateCounters.ties[d];
+            equal = false;
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Position walk:  " << positionSeconds << " s, " << std::setprecision(0) << positionCounters.getTotalNodes() / positionSeconds << " nodes/s" << std::endl;
+    std::cout << std::setprecision(3);
+    std::cout << "GameState walk: " << gameStateSeconds << " s, " << std::setprecision(0) << gameStateCounters.getTotalNodes() / gameStateSeconds << " nodes/s" << std::endl;
+    if (!equal){
+        std::cout << "ERROR: the walks don't match" << std::endl;
+    }
+    return equal;
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include <string>
+
+
+#define MAX_PERFT_DEPTH 17          //1 move to choose the first meeple + 16 moves to set the meeples
+
+
+//Walks the complete game tree up to depth compound moves (see MoveGenerator.h), and prints the number of positions, wins and ties per depth
+//The tree is walked twice: with Position/generateMoves(), and with GameState::play()/undo() (Board, MeepleBag); the counts have to be equal
+//position: start position in the format of Position::fromString(); empty: the beginning of a game
+bool runPerft(unsigned int depth, const std::string& position);     //returns false, if the position is invalid, or if both walks don't match
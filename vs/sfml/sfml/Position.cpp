@@ -0,0 +1,182 @@
+#include "Position.h"
+
+#include <assert.h>
+#include <type_traits>
+
+#include "GameState.h"
+#include "MeepleBag.h"
+#include "Meeple.h"
+#include "Board.h"
+#include "Zobrist.h"
+
+
+static_assert(sizeof(Position) == 16, "Position should fit into 16 bytes");
+static_assert(std::is_trivially_copyable<Position>::value, "Position must be copyable with memcpy");
+
+
+Position Position::empty(){
+    Position position = { 0, 0, 0xFFFF, MeepleColor::WHITE, NO_MEEPLE };
+    return position;
+}
+
+Position Position::fromGameState(const GameState& gameState, const Meeple* meepleToSet){
+    Position position = { 0, 0, 0, static_cast<uint8_t>(gameState.ownBag->getBagColor()), NO_MEEPLE };
+
+    for (uint8_t f = 0; f < FIELD_COUNT; ++f){
+        const Meeple* meeple = gameState.board->getMeeple(BoardPos::fromFieldIndex(f));
+        if (meeple != nullptr){
+            position.cells |= static_cast<uint64_t>(meeple->getCode()) << (4 * f);
+            position.occupied |= static_cast<uint16_t>(1 << f);
+        }
+    }
+    position.available = gameState.ownBag->getAvailableMeeples() | gameState.opponentBag->getAvailableMeeples();
+    if (meepleToSet != nullptr){
+        position.meepleToSet = meepleToSet->getCode();
+        position.available &= static_cast<uint16_t>(~(1 << position.meepleToSet));     //The meeple might still be in the bag (depends on the caller)
+    }
+    return position;
+}
+
+void Position::applyTo(GameState& gameState) const{
+    gameState.board->reset();
+    gameState.ownBag->reset();
+    gameState.opponentBag->reset();
+
+    for (uint16_t fields = occupied; fields != 0; fields &= fields - 1){
+        uint8_t field = lowestBitIndex(fields);
+        Meeple meeple(getMeepleCode(field));
+        MeepleBag* bag = (gameState.ownBag->getBagColor() == meeple.getColor()) ? gameState.ownBag : gameState.opponentBag;
+        gameState.board->setMeeple(BoardPos::fromFieldIndex(field), *bag->removeMeeple(meeple));
+    }
+}
+
+
+static int parseHexDigit(char c){
+    if (c >= '0' && c <= '9'){ return c - '0'; }
+    if (c >= 'a' && c <= 'f'){ return c - 'a' + 10; }
+    if (c >= 'A' && c <= 'F'){ return c - 'A' + 10; }
+    return -1;
+}
+
+bool Position::fromString(const std::string& text, Position& position){
+    if (text.size() != FIELD_COUNT + 4 || text[FIELD_COUNT] != ' ' || text[FIELD_COUNT + 2] != ' '){
+        return false;
+    }
+    Position result = empty();
+    for (uint8_t f = 0; f < FIELD_COUNT; ++f){
+        if (text[f] == '.'){
+            continue;
+        }
+        int code = parseHexDigit(text[f]);
+        if (code < 0 || (result.available & (1 << code)) == 0){     //every meeple exists only once
+            return false;
+        }
+        result.setMeeple(f, static_cast<uint8_t>(code));
+    }
+
+    char side = text[FIELD_COUNT + 1];
+    if (side != 'w' && side != 'b'){
+        return false;
+    }
+    result.sideToMove = static_cast<uint8_t>(side == 'w' ? MeepleColor::WHITE : MeepleColor::BLACK);
+
+    if (text[FIELD_COUNT + 3] != '-'){
+        int code = parseHexDigit(text[FIELD_COUNT + 3]);
+        if (code < 0 || (result.available & (1 << code)) == 0 || (code & 1) != result.sideToMove){       //sideToMove sets its own color
+            return false;
+        }
+        result.meepleToSet = static_cast<uint8_t>(code);
+        result.available &= static_cast<uint16_t>(~(1 << code));
+    }
+    position = result;
+    return true;
+}
+
+std::string Position::toString() const{
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    std::string text;
+    for (uint8_t f = 0; f < FIELD_COUNT; ++f){
+        text += isFieldEmpty(f) ? '.' : HEX_DIGITS[getMeepleCode(f)];
+    }
+    text += ' ';
+    text += (sideToMove == MeepleColor::WHITE) ? 'w' : 'b';
+    text += ' ';
+    text += (meepleToSet == NO_MEEPLE) ? '-' : HEX_DIGITS[meepleToSet];
+    return text;
+}
+
+
+uint8_t Position::getMeepleCode(uint8_t field) const{
+    assert(field < FIELD_COUNT && !isFieldEmpty(field));
+    return static_cast<uint8_t>((cells >> (4 * field)) & 0xF);
+}
+
+bool Position::isFieldEmpty(uint8_t field) const{
+    assert(field < FIELD_COUNT);
+    return (occupied & (1 << field)) == 0;
+}
+
+bool Position::isFull() const{
+    return occupied == 0xFFFF;
+}
+
+void Position::setMeeple(uint8_t field, uint8_t code){
+    assert(isFieldEmpty(field) && code < 16);
+    cells |= static_cast<uint64_t>(code) << (4 * field);
+    occupied |= static_cast<uint16_t>(1 << field);
+    available &= static_cast<uint16_t>(~(1 << code));
+}
+
+void Position::removeMeeple(uint8_t field){
+    uint8_t code = getMeepleCode(field);
+    cells &= ~(static_cast<uint64_t>(0xF) << (4 * field));
+    occupied &= static_cast<uint16_t>(~(1 << field));
+    available |= static_cast<uint16_t>(1 << code);
+}
+
+
+bool Position::checkWinSituation() const{
+    for (uint8_t line = 0; line < WIN_LINE_COUNT; ++line){
+        if ((occupied & WIN_LINE_MASKS[line]) != WIN_LINE_MASKS[line]){
+            continue;
+        }
+        uint8_t andCode = 0xF, norCode = 0xF;
+        for (uint16_t fields = WIN_LINE_MASKS[line]; fields != 0; fields &= fields - 1){
+            uint8_t code = getMeepleCode(lowestBitIndex(fields));
+            andCode &= code;
+            norCode &= static_cast<uint8_t>(~code);
+        }
+        if (((andCode | norCode) & 0xF) != 0){
+            return true;
+        }
+    }
+    return false;
+}
+
+
+uint64_t Position::getHash() const{
+    uint64_t hash = 0;
+    for (uint16_t fields = occupied; fields != 0; fields &= fields - 1){
+        uint8_t field = lowestBitIndex(fields);
+        hash ^= ZOBRIST.field[field][getMeepleCode(field)];
+    }
+    for (uint16_t codes = available; codes != 0; codes &= codes - 1){
+        hash ^= ZOBRIST.inBag[lowestBitIndex(codes)];
+    }
+    if (meepleToSet != NO_MEEPLE){
+        hash ^= ZOBRIST.meepleToSet[meepleToSet];
+    }
+    if (sideToMove == MeepleColor::BLACK){
+        hash ^= ZOBRIST.blackToMove;
+    }
+    return hash;
+}
+
+
+bool Position::operator == (const Position& rhs) const{
+    return cells == rhs.cells && occupied == rhs.occupied && available == rhs.available && sideToMove == rhs.sideToMove && meepleToSet == rhs.meepleToSet;
+}
+
+bool Position::operator != (const Position& rhs) const{
+    return !(*this == rhs);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "Bitboard.h"
+
+class GameState;
+class Meeple;
+
+
+#define NO_MEEPLE 0xFF          //Position::meepleToSet: no meeple has been chosen yet
+
+
+//Compact snapshot of a game (16 bytes, trivially copyable)
+//In contrast to GameState, a Position doesn't reference any objects - it can be passed by value, stored in arrays, and hashed cheaply
+struct Position{
+    uint64_t cells;             //4 bits per field: bits 4f to 4f+3 contain the code of the meeple on field f (see Meeple::getCode()); 0 for empty fields
+    uint16_t occupied;          //bit f is set, if there is a meeple on field f
+    uint16_t available;         //bit c is set, if the meeple with the code c is still in a bag (and hasn't been chosen as meepleToSet)
+    uint8_t sideToMove;         //Color (MeepleColor::Enum) of the player, who has to act next (set the meepleToSet, or choose a meeple for the opponent)
+    uint8_t meepleToSet;        //Code of the meeple, which has been chosen for sideToMove; NO_MEEPLE, if sideToMove has to choose a meeple
+
+    static Position empty();                                                            //The position at the beginning of a game (white has to choose a meeple for black)
+    static Position fromGameState(const GameState& gameState, const Meeple* meepleToSet);  //Snapshot of the gameState; sideToMove is the color of gameState.ownBag
+    void applyTo(GameState& gameState) const;                                           //Resets the board and the bags of the gameState, and sets all meeples of this position (meepleToSet stays in its bag)
+
+    //Text format: 16 fields row by row ('.' = empty, '0'-'f' = meeple code), the side to move ('w'/'b'), and the meepleToSet ('0'-'f', or '-')
+    //Example: "5...........a... w 2"; the available meeples are all meeples, which are neither on the board nor the meepleToSet
+        static bool fromString(const std::string& text, Position& position);            //returns false, if the text is not a valid position
+        std::string toString() const;
+
+    uint8_t getMeepleCode(uint8_t field) const;         //Returns the code of the meeple on the field; the field must not be empty
+    bool isFieldEmpty(uint8_t field) const;
+    bool isFull() const;
+
+    //In-place make/unmake of a single meeple (doesn't change sideToMove and meepleToSet):
+        void setMeeple(uint8_t field, uint8_t code);    //Sets the meeple to the field, and marks it as not available
+        void removeMeeple(uint8_t field);               //Removes the meeple from the field, and marks it as available again
+
+    bool checkWinSituation() const;                     //true, if there are 4 similar meeples in a row/col/diagonal
+    uint64_t getHash() const;                           //Zobrist-hash of the position (calculated from scratch; same as GameState::getHash())
+
+    bool operator == (const Position& rhs) const;
+    bool operator != (const Position& rhs) const;
+};
@@ -0,0 +1,160 @@
+#include "ProofNumberSearch.h"
+
+#include <iomanip>
+#include <string.h>
+#include <assert.h>
+
+#include "Meeple.h"
+
+
+#define PN_INFINITY 0xFFFFFFFFu
+
+
+static uint32_t addNumbers(uint32_t lhs, uint32_t rhs){       //Saturating addition (infinity stays infinity)
+    return (lhs >= PN_INFINITY - rhs) ? PN_INFINITY : lhs + rhs;
+}
+
+
+
+ProofNumberSearch::ProofNumberSearch(unsigned int nodeBudget) : cache(PNS_CACHE_ENTRIES), nodeBudget(nodeBudget), searchCount(0), cacheHits(0), winCount(0), lossCount(0){
+    nodes.reserve(nodeBudget + MAX_COMPOUND_MOVES);
+    memset(&cache[0], 0, cache.size() * sizeof(CacheEntry));
+}
+
+
+ProofResult::Enum ProofNumberSearch::prove(const GameState& gameState, const Meeple* meepleToSet, CompoundMove& move){
+    return prove(Position::fromGameState(gameState, meepleToSet), move);
+}
+
+ProofResult::Enum ProofNumberSearch::prove(const Position& position, CompoundMove& move){
+    if (FIELD_COUNT - popcount16(position.occupied) > PNS_MAX_EMPTY_FIELDS){
+        return ProofResult::UNKNOWN;
+    }
+
+    const uint64_t key = position.getHash() | 1;        //never 0 (= empty entry)
+    CacheEntry& entry = cache[static_cast<size_t>((key >> 1) & (PNS_CACHE_ENTRIES - 1))];
+    if (entry.key == key){
+        ++cacheHits;
+        move = entry.move;
+        return static_cast<ProofResult::Enum>(entry.result);
+    }
+
+    ++searchCount;
+    ProofResult::Enum result = ProofResult::UNKNOWN;
+    move.field = NO_FIELD;
+    move.give = NO_MEEPLE;
+    if (search(position, position.sideToMove, move)){
+        result = ProofResult::WIN;
+        ++winCount;
+    }else{
+        CompoundMove opponentMove;
+        if (search(position, static_cast<uint8_t>(position.sideToMove ^ 1), opponentMove)){
+            result = ProofResult::LOSS;
+            ++lossCount;
+        }
+    }
+
+    entry.key = key;
+    entry.result = static_cast<uint8_t>(result);
+    entry.move = move;
+    return result;
+}
+
+
+bool ProofNumberSearch::search(const Position& root, uint8_t goalSide, CompoundMove& move){
+    nodes.clear();
+    Node rootNode = { 1, 1, -1, -1, 0, { NO_FIELD, NO_MEEPLE } };
+    nodes.push_back(rootNode);
+
+    while (nodes[0].proof != 0 && nodes[0].disproof != 0 && nodes.size() + MAX_COMPOUND_MOVES <= nodes.capacity() && nodes.size() < nodeBudget){
+        //Descend to the most-proving node: at the goal side's turn the child, which is the easiest to prove, otherwise the one, which is the easiest to disprove
+        Position position = root;
+        int32_t index = 0;
+        while (nodes[index].firstChild >= 0){
+            const Node& node = nodes[index];
+            const bool orNode = (position.sideToMove == goalSide);
+            int32_t best = node.firstChild;
+            for (int32_t c = node.firstChild + 1; c < node.firstChild + node.childCount; ++c){
+                if (orNode ? nodes[c].proof < nodes[best].proof : nodes[c].disproof < nodes[best].disproof){
+                    best = c;
+                }
+            }
+            position = playMove(position, nodes[best].move);
+            index = best;
+        }
+
+        expand(index, position, goalSide);
+
+        //The numbers of all ancestors (the side to move alternates with each compound move):
+        bool orNode = (position.sideToMove == goalSide);
+        for (int32_t n = index; n >= 0; n = nodes[n].parent){
+            update(n, orNode);
+            orNode = !orNode;
+        }
+    }
+
+    if (nodes[0].proof != 0){
+        return false;
+    }
+    if (root.sideToMove == goalSide){
+        for (int32_t c = nodes[0].firstChild; c < nodes[0].firstChild + nodes[0].childCount; ++c){
+            if (nodes[c].proof == 0){
+                move = nodes[c].move;
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+void ProofNumberSearch::expand(int32_t index, const Position& position, uint8_t goalSide){
+    MoveList moves;
+    generateMoves(position, moves, MoveFilter::NO_LOSING_GIVES);       //A meeple, with which the opponent wins immediately, is never better than another one
+    assert(moves.count > 0 && moves.count <= 0xFF);
+
+    nodes[index].firstChild = static_cast<int32_t>(nodes.size());
+    nodes[index].childCount = static_cast<uint8_t>(moves.count);
+    for (unsigned int m = 0; m < moves.count; ++m){
+        const CompoundMove& move = moves.moves[m];
+        Node child = { 1, 1, index, -1, 0, move };
+
+        //Terminal nodes: proof = 0 (the goal side has won) or disproof = 0 (the goal side can't win anymore)
+        int winner = -1;                //-1: the game goes on, 2: tie
+        if (move.give == NO_MEEPLE){    //The game is over after setting the meeple
+            winner = isWinningField(position, move.field, position.meepleToSet) ? position.sideToMove : 2;
+        }else{
+            const Position next = playMove(position, move);
+            if ((getWinningCodes(next) & (1 << next.meepleToSet)) != 0){
+                winner = next.sideToMove;       //The opponent wins with the given meeple
+            }
+        }
+        if (winner >= 0){
+            child.proof = (winner == goalSide) ? 0 : PN_INFINITY;
+            child.disproof = (winner == goalSide) ? PN_INFINITY : 0;
+        }
+        nodes.push_back(child);
+    }
+}
+
+void ProofNumberSearch::update(int32_t index, bool orNode){
+    Node& node = nodes[index];
+    if (node.firstChild < 0){
+        return;
+    }
+    uint32_t minimum = PN_INFINITY;
+    uint32_t sum = 0;
+    for (int32_t c = node.firstChild; c < node.firstChild + node.childCount; ++c){
+        const uint32_t forMinimum = orNode ? nodes[c].proof : nodes[c].disproof;
+        minimum = (forMinimum < minimum) ? forMinimum : minimum;
+        sum = addNumbers(sum, orNode ? nodes[c].disproof : nodes[c].proof);
+    }
+    node.proof = orNode ? minimum : sum;            //Goal side to move: one proven child is enough; otherwise all children have to be proven
+    node.disproof = orNode ? sum : minimum;
+}
+
+
+void ProofNumberSearch::printStatistics(std::ostream& output) const{
+    const double searches = searchCount > 0 ? static_cast<double>(searchCount) : 1.;
+    output << std::fixed << std::setprecision(1)
+        << "proof-number search: " << searchCount << " searches (" << cacheHits << " cache hits), wins: " << 100. * winCount / searches << "%, losses: " << 100. * lossCount / searches << "%" << std::endl;
+}
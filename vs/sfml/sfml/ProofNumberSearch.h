@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <ostream>
+
+#include "Position.h"
+#include "MoveGenerator.h"
+
+class GameState;
+class Meeple;
+
+
+//Proof-number search: tries to prove, that the side to move wins (or loses) by force, within a budget of nodes
+//Many positions in the mid-game are decided by short forcing sequences (e.g. every meeple, which can be given away, lets the opponent win) -
+//the search grows its tree towards the moves, which are the easiest to prove or disprove, so it finds these sequences much faster than a full-width search
+//A win is searched first, then a loss; a draw by a full board counts as neither of them
+//The results are cached by the Zobrist-hash of the position, so a repeated position doesn't cost a second search
+
+
+#define PNS_DEFAULT_NODES 4000              //Node budget of each of the 2 searches (win, loss)
+#define PNS_MAX_EMPTY_FIELDS 12             //Positions with more empty fields aren't searched (there are no short forcing sequences in the opening)
+#define PNS_CACHE_ENTRIES 4096              //Power of 2
+
+
+struct ProofResult{
+    enum Enum{
+        UNKNOWN = 0,        //Nothing has been proven within the budget (or the position isn't searched)
+        WIN = 1,            //The side to move wins with the proof move
+        LOSS = 2            //The side to move loses against every defence
+    };
+};
+
+
+class ProofNumberSearch{
+private:
+    struct Node{
+        uint32_t proof;             //Number of leaves, which still have to be proven, to prove that the goal side wins
+        uint32_t disproof;          //Number of leaves, which still have to be proven, to prove that the goal side doesn't win
+        int32_t parent;             //-1 for the root
+        int32_t firstChild;         //The children are stored one after another; -1, if the node isn't expanded
+        uint8_t childCount;
+        CompoundMove move;          //Move of the parent to this node
+    };
+    struct CacheEntry{
+        uint64_t key;               //0 = empty
+        uint8_t result;             //ProofResult::Enum
+        CompoundMove move;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<CacheEntry> cache;
+    const unsigned int nodeBudget;
+
+    uint64_t searchCount;           //Positions, which have been searched (not found in the cache)
+    uint64_t cacheHits;
+    uint64_t winCount;
+    uint64_t lossCount;
+
+    bool search(const Position& root, uint8_t goalSide, CompoundMove& move);       //Returns true, if goalSide wins by force; move = the proof move, if goalSide is to move
+    void expand(int32_t index, const Position& position, uint8_t goalSide);
+    void update(int32_t index, bool orNode);                        //Recalculates the numbers of the node from its children (orNode: the goal side is to move)
+
+    ProofNumberSearch(const ProofNumberSearch&);
+    ProofNumberSearch& operator = (const ProofNumberSearch&);
+public:
+    explicit ProofNumberSearch(unsigned int nodeBudget = PNS_DEFAULT_NODES);
+
+    ProofResult::Enum prove(const Position& position, CompoundMove& move);        //move = the proof move, if the result is WIN
+    ProofResult::Enum prove(const GameState& gameState, const Meeple* meepleToSet, CompoundMove& move);    //The same for Position::fromGameState()
+
+    void printStatistics(std::ostream& output) const;
+};
@@ -0,0 +1,58 @@
+#include "ScoreMapCache.h"
+
+#include <iomanip>
+#include <string.h>
+#include <assert.h>
+
+
+
+ScoreMapCache::ScoreMapCache() : entries(SCORE_MAP_CACHE_ENTRIES), probeCount(0), hitCount(0), overwriteCount(0){
+    clear();
+}
+
+void ScoreMapCache::clear(){
+    memset(&entries[0], 0, entries.size() * sizeof(Entry));
+}
+
+
+bool ScoreMapCache::probe(uint64_t key, int* scoreMap){
+    assert(key != 0);
+    ++probeCount;
+    const Entry& entry = entries[static_cast<size_t>(key & (SCORE_MAP_CACHE_ENTRIES - 1))];
+    if (entry.key != key){
+        return false;
+    }
+    ++hitCount;
+    memcpy(scoreMap, entry.scoreMap, sizeof(entry.scoreMap));
+    return true;
+}
+
+void ScoreMapCache::store(uint64_t key, const int* scoreMap){
+    assert(key != 0);
+    Entry& entry = entries[static_cast<size_t>(key & (SCORE_MAP_CACHE_ENTRIES - 1))];
+    if (entry.key != 0 && entry.key != key){
+        ++overwriteCount;
+    }
+    entry.key = key;
+    memcpy(entry.scoreMap, scoreMap, sizeof(entry.scoreMap));
+}
+
+
+uint64_t ScoreMapCache::getProbeCount() const{
+    return probeCount;
+}
+
+uint64_t ScoreMapCache::getHitCount() const{
+    return hitCount;
+}
+
+void ScoreMapCache::printStatistics(std::ostream& output) const{
+    size_t used = 0;
+    for (size_t i = 0; i < entries.size(); ++i){
+        used += (entries[i].key != 0) ? 1 : 0;
+    }
+    const double probes = probeCount > 0 ? static_cast<double>(probeCount) : 1.;
+    output << std::fixed << std::setprecision(1)
+        << "score map cache: " << probeCount << " probes, hits: " << 100. * hitCount / probes << "%, overwrites: " << overwriteCount
+        << ", filled: " << 100. * used / entries.size() << "% of " << entries.size() << " maps" << std::endl;
+}
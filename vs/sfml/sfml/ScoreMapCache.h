@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <ostream>
+
+#include "Bitboard.h"
+
+
+//Cache for the score maps of the ThinkingAI and the SmartAI (see ThinkingAI::buildScoreMaps())
+//The AIs rate the same (board, meeple) pairs again and again: every candidate meeple in each turn, and the same early positions in every game
+//The cache is direct-mapped and bounded: a new map replaces the map in its slot. Each AI owns its cache, so it needs no locks (one AI = one thread)
+
+
+#define SCORE_MAP_CACHE_ENTRIES 8192        //Power of 2; 72 bytes per entry
+
+
+class ScoreMapCache{
+private:
+    struct Entry{
+        uint64_t key;                       //0 = empty
+        int scoreMap[FIELD_COUNT];
+    };
+    std::vector<Entry> entries;
+
+    uint64_t probeCount;
+    uint64_t hitCount;
+    uint64_t overwriteCount;
+public:
+    ScoreMapCache();
+
+    void clear();                                           //Removes all maps (the counters are kept)
+
+    bool probe(uint64_t key, int* scoreMap);                //Returns true and copies the map, if the key is in the cache; the key must not be 0
+    void store(uint64_t key, const int* scoreMap);
+
+    uint64_t getProbeCount() const;
+    uint64_t getHitCount() const;
+    void printStatistics(std::ostream& output) const;       //Prints the counters and the fill rate
+};
@@ -0,0 +1,45 @@
+#pragma once
+#include <chrono>
+
+
+//Limits for the searching AIs (see SolverAI, MctsAI)
+//  depth > 0:    fixed-depth mode - iterative deepening stops after this number of turns (reproducible results, e.g. for the simulator)
+//  playouts > 0: fixed number of playouts for Monte Carlo AIs (reproducible results)
+//  moveTime > 0: fixed-deadline mode - the search stops, when the time is up; for iterative deepening, the best move of the last completed iteration is played
+//  all 0:        the AI's own default
+struct SearchLimits{
+    unsigned int depth;         //Max. number of turns to search
+    float moveTime;             //Max. seconds per decision
+    unsigned int playouts;      //Max. number of playouts per decision
+
+    SearchLimits(unsigned int depth = 0, float moveTime = 0, unsigned int playouts = 0) : depth(depth), moveTime(moveTime), playouts(playouts){}
+
+    bool isDefault() const{
+        return depth == 0 && moveTime <= 0 && playouts == 0;
+    }
+};
+
+
+//Measures the time since the start of a search, and tells if the deadline of the SearchLimits has passed
+class SearchTimer{
+private:
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point deadline;
+    bool hasDeadline;
+public:
+    SearchTimer() : start(std::chrono::steady_clock::now()), deadline(start), hasDeadline(false){}
+
+    void restart(const SearchLimits& limits){
+        start = std::chrono::steady_clock::now();
+        hasDeadline = limits.moveTime > 0;
+        deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(limits.moveTime));
+    }
+
+    bool isExpired() const{
+        return hasDeadline && std::chrono::steady_clock::now() >= deadline;
+    }
+
+    double getElapsedSeconds() const{
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+};
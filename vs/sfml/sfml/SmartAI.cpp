@@ -4,6 +4,11 @@
 #include "MeepleBag.h"
 #include "config.h"
 #include "GameState.h"
+#include "Position.h"
+#include "Tablebase.h"
+#include "OpeningBook.h"
+#include "Bitboard.h"
+#include "ProofNumberSearch.h"
 
 #include <iostream>
 #include <assert.h>
@@ -12,25 +17,303 @@
 
 
 
-SmartAI::SmartAI(bool intelligentMeepleChoosing, bool intelligentMeeplePositioning) : ThinkingAI(intelligentMeepleChoosing, intelligentMeeplePositioning){
+SmartAI::SmartAI(bool intelligentMeepleChoosing, bool intelligentMeeplePositioning, const HeuristicParameters& parameters) : ThinkingAI(intelligentMeepleChoosing, intelligentMeeplePositioning, parameters){
+    //The penalty of the opponent's bag - the same calculation as in combineMeeples:
+    for (unsigned int count = 0; count <= THINKING_AI_MAX_MEEPLES; ++count){
+        for (unsigned int similar = 0; similar <= THINKING_AI_MAX_MEEPLES; ++similar){
+            if (count == 0){
+                combinePenalty[count][similar] = 1;
+            }else{
+                unsigned int opponentMatches = similar / count;
+                combinePenalty[count][similar] = -static_cast<int>(opponentMatches / static_cast<float>(count) * static_cast<float>(parameters.get(HeuristicParameter::SMART_OPPONENT_PENALTY)));
+            }
+        }
+    }
+}
+
+
+const Meeple& SmartAI::selectOpponentsMeeple(const GameState& gameState){
+    CompoundMove move;
+    const Position position = Position::fromGameState(gameState, nullptr);
+    if (intelligentMeepleChoosing && (OpeningBook::getGlobal().probe(position, move) || Tablebase::getGlobal().probe(position, move)
+        || proofSearch.prove(position, move) == ProofResult::WIN)){
+        for (unsigned int i = 0; i < gameState.opponentBag->getMeepleCount(); ++i){
+            if (gameState.opponentBag->getMeeple(i)->getCode() == move.give){
+                return *gameState.opponentBag->getMeeple(i);
+            }
+        }
+        assert(false);      //the meeple has to be in the opponent's bag
+    }
+    return ThinkingAI::selectOpponentsMeeple(gameState);
 }
 
+BoardPos SmartAI::selectMeeplePosition(const GameState& gameState, const Meeple& meepleToSet){
+    CompoundMove move;
+    const Position position = Position::fromGameState(gameState, &meepleToSet);
+    if (intelligentMeeplePositioning && (OpeningBook::getGlobal().probe(position, move) || Tablebase::getGlobal().probe(position, move)
+        || proofSearch.prove(position, move) == ProofResult::WIN)){
+        return BoardPos::fromFieldIndex(move.field);
+    }
+    return ThinkingAI::selectMeeplePosition(gameState, meepleToSet);
+}
+
+void SmartAI::printStatistics(std::ostream& output) const{
+    ThinkingAI::printStatistics(output);
+    proofSearch.printStatistics(output);
+}
+
+
+
+
+
 
 
 
 
+//A line with 1-3 meeples is reduced to an index relative to the meepleToSet (see getPointsForAllMeeples()):
+//  3 bits for each property p: bit 3p = the first meeple of the line (the ancestor) has another value than the meepleToSet,
+//  bits 3p+1 - 3p+2 = number of meeples with another value than the ancestor; bits 12-13 = number of meeples - 1
+//The points only depend on this index and on the opponent's bag: the meeples after the ancestor only count by their properties
+#define SMART_AI_LINE_INDEX_COUNT (3 << 12)
 
+//An entry of the line table, contains everything of combineMeeples and blockOpponent except the opponent's bag:
+#define LINE_MATCH_2_MASK 0x000F        //properties, which 2 meeples share with the meepleToSet (the opponent might win there)
+#define LINE_MATCH_1_SHIFT 4            //3 bits: number of properties, which 1 meeple shares with the meepleToSet
+#define LINE_WIN 0x0080                 //3 meeples share a property with the meepleToSet --> we win
+#define LINE_BLOCK_SHIFT 8              //2 bits per property: number of meeples, which the meepleToSet blocks (0, if blocking makes no sense)
 
 
+//Lookup tables, filled once at startup (VS2013 doesn't support constexpr)
+struct SmartAITables{
+    uint16_t line[SMART_AI_LINE_INDEX_COUNT];
+    uint16_t codeSpread[16];                    //[meeple code]: bit p of the code moved to bit 3p (the layout of the line index)
+    float blockImportance[THINKING_AI_MAX_MEEPLES + 1][THINKING_AI_MAX_MEEPLES + 1][4];            //[opponent's meeples][similar meeples][blocked meeples]: importance of blocking the property
+
+    SmartAITables();
+};
+static const SmartAITables TABLES;
+
+SmartAITables::SmartAITables(){
+    for (unsigned int code = 0; code < 16; ++code){
+        codeSpread[code] = static_cast<uint16_t>((code & 1) | (code & 2) << 2 | (code & 4) << 4 | (code & 8) << 6);
+    }
+
+    //The opponent's bag - the same calculation as in blockOpponent:
+    for (unsigned int count = 0; count <= THINKING_AI_MAX_MEEPLES; ++count){
+        for (unsigned int similar = 0; similar <= THINKING_AI_MAX_MEEPLES; ++similar){
+            for (int match = 0; match < 4; ++match){
+                float similarMeeplesInBag = (count == 0) ? 0.f : 100.f * similar / static_cast<float>(count);       //(the original gets NaN for an empty bag, which never is the highest importance)
+                blockImportance[count][similar][match] = similarMeeplesInBag * match / 3;
+            }
+        }
+    }
+
+    //The lines:
+    for (unsigned int index = 0; index < SMART_AI_LINE_INDEX_COUNT; ++index){
+        const int meeples = (index >> 12) + 1;
+        line[index] = 0;
+
+        int help = 0;
+        int block = 0;
+        bool valid = true;
+        bool neverBlock = false;
+        uint16_t entry = 0;
+        uint16_t blockMatches = 0;
+        for (unsigned int p = 0; p < PROPERTY_COUNT; ++p){
+            const bool ancestorDiffers = ((index >> (3 * p)) & 1) != 0;
+            const int others = (index >> (3 * p + 1)) & 3;      //meeples, which differ from the ancestor
+            if (others >= meeples){
+                valid = false;          //the ancestor itself can't differ
+                break;
+            }
+
+            //combineMeeples: number of meeples with the same property as the meepleToSet
+            const int match = ancestorDiffers ? others : meeples - others;
+            if (match >= 3){
+                entry = static_cast<uint16_t>(entry | LINE_WIN);
+            }else if (match == 2){
+                entry = static_cast<uint16_t>(entry | 1 << p);
+            }else if (match == 1){
+                entry = static_cast<uint16_t>(entry + (1 << LINE_MATCH_1_SHIFT));
+            }
+
+            //blockOpponent: number of meeples, if all of them share the property
+            int blockMatch = (others == 0) ? meeples : 0;
+            if (!ancestorDiffers){          //we can't block the opponent with our meeple
+                if (blockMatch == 2){
+                    neverBlock = true;
+                }
+                if (blockMatch % 2 == 0){
+                    ++help;
+                }
+                blockMatch = 0;
+            }else if (blockMatch % 2 == 1){
+                ++block;
+            }
+            blockMatches = static_cast<uint16_t>(blockMatches | blockMatch << (2 * p));
+        }
+        if (!valid){
+            continue;
+        }
+        if (!neverBlock && help < block){
+            entry = static_cast<uint16_t>(entry | blockMatches << LINE_BLOCK_SHIFT);
+        }
+        line[index] = entry;
+    }
+}
 
-#define HIGHEST_SINGLE_POINTS 1000
 
 
 int SmartAI::getPointsForCombination(const GameState& gameState, const WinCombination& winCombination, const Meeple& meepleToSet) const{
+    const Meeple* meeple = &meepleToSet;
+    int points;
+    getPointsForAllMeeples(gameState, winCombination, &meeple, 1, &points);
+    return points;
+}
+
+void SmartAI::getPointsForAllMeeples(const GameState& gameState, const WinCombination& winCombination, const Meeple* const* meeples, unsigned int meepleCount, int* points) const{
+    //The line index (relative to the meepleToSet code 0):
+    unsigned int placed = 0;
+    uint8_t ancestor = 0;
+    unsigned int lineIndex = 0;
+    for (unsigned int m = 0; m < 4; ++m){
+        if (winCombination.meeples[m] == nullptr){
+            continue;
+        }
+        if (placed++ == 0){
+            ancestor = winCombination.meeples[m]->getCode();
+            lineIndex = TABLES.codeSpread[ancestor];
+        }else{
+            lineIndex += TABLES.codeSpread[winCombination.meeples[m]->getCode() ^ ancestor] << 1;     //counts the differences of each property (max. 2)
+        }
+    }
+    if (placed == 0 || placed == 4){        //Nothing todo
+        for (unsigned int i = 0; i < meepleCount; ++i){
+            points[i] = 0;
+        }
+        return;
+    }
+    lineIndex |= (placed - 1) << 12;
+
+    //The opponent's bag (the number of meeples with each property-value):
+    const unsigned int opponentMeepleCount = gameState.opponentBag->getMeepleCount();
+    const uint16_t opponentMeeples = gameState.opponentBag->getAvailableMeeples();
+    assert(opponentMeepleCount <= THINKING_AI_MAX_MEEPLES);
+    int planePenalty[PROPERTY_PLANE_COUNT];
+    const float* planeImportance[PROPERTY_PLANE_COUNT];
+    for (unsigned int plane = 0; plane < PROPERTY_PLANE_COUNT; ++plane){
+        const unsigned int similar = popcount16(opponentMeeples & MEEPLE_PROPERTY_MASKS[plane]);
+        planePenalty[plane] = combinePenalty[opponentMeepleCount][similar];
+        planeImportance[plane] = TABLES.blockImportance[opponentMeepleCount][similar];
+    }
+
+    for (unsigned int i = 0; i < meepleCount; ++i){
+        const uint8_t code = meeples[i]->getCode();
+        const uint16_t entry = TABLES.line[lineIndex ^ TABLES.codeSpread[code]];
+
+        if (entry & LINE_WIN){      //we can win the game --> return lots of points, so that we will choose that field
+            points[i] = parameters.get(HeuristicParameter::SMART_WIN_POINTS);
+        }else{
+            int combined = ((entry >> LINE_MATCH_1_SHIFT) & 7) * parameters.get(HeuristicParameter::SMART_MATCH_POINTS);
+            float reduction = 0.f;
+            for (unsigned int p = 0; p < PROPERTY_COUNT; ++p){
+                const unsigned int value = (code >> p) & 1;
+                if (entry & (1 << p)){
+                    combined += planePenalty[getPropertyPlaneIndex(p, value)];
+                }
+                const float importance = planeImportance[getPropertyPlaneIndex(p, value ^ 1)][(entry >> (LINE_BLOCK_SHIFT + 2 * p)) & 3];     //The ancestor has the other value
+                if (importance > reduction){
+                    reduction = importance;
+                }
+            }
+            if (combined > 0){
+                points[i] = static_cast<int>(combined * (100.f - reduction) / 100.f);      //Remove 0-100% from the already calculated points
+            }else{
+                points[i] = static_cast<int>(combined * reduction / 100.f);
+            }
+        }
+
+        #if SMART_AI_CHECK_TABLES
+            assert(points[i] == getPointsForCombination_reference(gameState, winCombination, *meeples[i]));
+        #endif
+    }
+}
+
+
+unsigned int SmartAI::checkLineTables(std::ostream& output) const{
+    Meeple* meeples[16];
+    for (uint8_t code = 0; code < 16; ++code){
+        meeples[code] = new Meeple(code);
+    }
+    Board board;
+    int points[16];
+    unsigned int mismatches = 0;
+    uint64_t checks = 0;
+
+    for (unsigned int color = 0; color < 2; ++color){
+        MeepleBag ownBag(color == 0 ? MeepleColor::BLACK : MeepleColor::WHITE);
+        MeepleBag opponentBag(color == 0 ? MeepleColor::WHITE : MeepleColor::BLACK);
+        GameState gameState(&ownBag, &opponentBag, &board);
+        const uint8_t colorBit = static_cast<uint8_t>(opponentBag.getMeeple(0)->getCode() & 1);
+
+        for (unsigned int bagMask = 0; bagMask < 256; ++bagMask){      //bit i = the meeple with the code 2i + color is in the bag
+            opponentBag.reset();
+            for (unsigned int i = 0; i < 8; ++i){
+                if ((bagMask & (1 << i)) == 0){
+                    opponentBag.removeMeeple(*meeples[2 * i + colorBit]);
+                }
+            }
+
+            //Every placement of 0-3 meeples in the line (full lines are always 0 points and have no table entry):
+            for (unsigned int fieldMask = 0; fieldMask < 15; ++fieldMask){
+                const unsigned int placed = popcount16(static_cast<uint16_t>(fieldMask));
+                for (unsigned int codes = 0; codes < (1u << (4 * placed)); ++codes){
+                    WinCombination winCombination;
+                    unsigned int next = 0;
+                    for (unsigned int m = 0; m < 4; ++m){
+                        winCombination.meeples[m] = nullptr;
+                        if (fieldMask & (1 << m)){
+                            winCombination.meeples[m] = meeples[(codes >> (4 * next++)) & 15];
+                        }
+                    }
+
+                    getPointsForAllMeeples(gameState, winCombination, meeples, 16, points);
+                    for (unsigned int code = 0; code < 16; ++code){
+                        ++checks;
+                        const int reference = getPointsForCombination_reference(gameState, winCombination, *meeples[code]);
+                        if (points[code] != reference && ++mismatches <= 10){
+                            output << "ERROR: the line table differs from the original calculation (line";
+                            for (unsigned int m = 0; m < 4; ++m){
+                                output << " " << (winCombination.meeples[m] == nullptr ? -1 : static_cast<int>(winCombination.meeples[m]->getCode()));
+                            }
+                            output << ", meepleToSet " << code << ", opponent's bag 0x" << std::hex << opponentBag.getAvailableMeeples() << std::dec
+                                << "): " << points[code] << " instead of " << reference << std::endl;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    output << checks << " combinations checked, " << mismatches << " mismatches" << std::endl;
+    for (unsigned int code = 0; code < 16; ++code){
+        delete meeples[code];
+    }
+    return mismatches;
+}
+
+
+uint64_t SmartAI::getScoreMapKey(const GameState& gameState, const Meeple& meepleToSet) const{
+    return ThinkingAI::getScoreMapKey(gameState, meepleToSet) ^ gameState.opponentBag->getHash();
+}
+
+
+int SmartAI::getPointsForCombination_reference(const GameState& gameState, const WinCombination& winCombination, const Meeple& meepleToSet) const{
     int points = getPointsForCombination_combineMeeples(gameState, winCombination, meepleToSet);
-    assert(points <= HIGHEST_SINGLE_POINTS);
+    const int winPoints = parameters.get(HeuristicParameter::SMART_WIN_POINTS);
+    assert(points <= winPoints);
     
-    if (points >= HIGHEST_SINGLE_POINTS){       //we can win the game --> return lots of points, so that we will choose that field
+    if (points >= winPoints){       //we can win the game --> return lots of points, so that we will choose that field
         return points;
     }
 
@@ -84,7 +367,7 @@ int SmartAI::getPointsForCombination_combineMeeples(const GameState& gameState,
     int points = 0;
     for (m = 0; m < 4; ++m){
         if (match[m] >= 3){                         //if we set the meeple there, we can win the game
-            return HIGHEST_SINGLE_POINTS;           //always choose this position
+            return parameters.get(HeuristicParameter::SMART_WIN_POINTS);       //always choose this position
         }
 
         if (match[m] == 2){         //we MUST NOT set the meeple there, if the opponent has a meeple that could win the game
@@ -98,11 +381,11 @@ int SmartAI::getPointsForCombination_combineMeeples(const GameState& gameState,
             unsigned int opponentMatches = gameState.opponentBag->getSimilarMeepleCount(meepleToSet.getProperty(m));
             opponentMatches /= opponentMeepleCount;     //percent-value
 
-            points -= static_cast<int>(opponentMatches / static_cast<float>(opponentMeepleCount) * 50.f); //worst case: happens at 11 properties (4*2 + 3). The 12 property could lead to a win. --> the value must not exceed HIGHEST_SINGLE_POINTS/11 (=90)
+            points -= static_cast<int>(opponentMatches / static_cast<float>(opponentMeepleCount) * static_cast<float>(parameters.get(HeuristicParameter::SMART_OPPONENT_PENALTY))); //worst case: happens at 11 properties (4*2 + 3). The 12 property could lead to a win. --> the value must not exceed SMART_WIN_POINTS/11 (=90)
 
         }
-        if (match[m] == 1){         //best case: happens at 11 properties (4*2 + 3). The 12. property could be a "never set there" --> the value therefore must be < 50/11 (=4)
-            ++points;
+        if (match[m] == 1){         //best case: happens at 11 properties (4*2 + 3). The 12. property could be a "never set there" --> the value therefore must be < SMART_OPPONENT_PENALTY/11 (=4)
+            points += parameters.get(HeuristicParameter::SMART_MATCH_POINTS);
         }
     }
     return points;
@@ -1,14 +1,34 @@
 #pragma once
 
 #include "ThinkingAI.h"
+#include "ProofNumberSearch.h"
 
 
 class SmartAI : public ThinkingAI {
     private:
+        ProofNumberSearch proofSearch;
+        int combinePenalty[THINKING_AI_MAX_MEEPLES + 1][THINKING_AI_MAX_MEEPLES + 1];     //[opponent's meeples][similar meeples]: points of a property, which 2 meeples share with the meepleToSet (depends on the parameters)
+
+        //The original calculation of the points; the AI uses lookup tables with the same results (see SMART_AI_CHECK_TABLES)
+        int getPointsForCombination_reference(const GameState& gameState, const WinCombination& winCombination, const Meeple& meepleToSet) const;
         int getPointsForCombination_combineMeeples(const GameState& gameState, const WinCombination& winCombination, const Meeple& meepleToSet) const;
         float getPointsForCombination_blockOpponent(const GameState& gameState, const WinCombination& winCombination, const Meeple& meepleToSet) const;
     protected:
         virtual int getPointsForCombination(const GameState& gameState, const WinCombination& winCombination, const Meeple& meepleToSet) const;
+        //The line is reduced to a table index once, each meeple is rated with a lookup of the index and the opponent's bag
+        virtual void getPointsForAllMeeples(const GameState& gameState, const WinCombination& winCombination, const Meeple* const* meeples, unsigned int meepleCount, int* points) const;
+        virtual uint64_t getScoreMapKey(const GameState& gameState, const Meeple& meepleToSet) const;      //The points also depend on the opponent's bag
     public:
-        SmartAI(bool intelligentMeepleChoosing = true, bool intelligentMeeplePositioning = true);
+        SmartAI(bool intelligentMeepleChoosing = true, bool intelligentMeeplePositioning = true, const HeuristicParameters& parameters = HeuristicParameters::getGlobal());
+
+        //In the opening and the endgame, the moves are taken from the opening book and the tablebase (see OpeningBook.h, Tablebase.h), if they know the position
+        //Otherwise a short proof-number search looks for a forced win (see ProofNumberSearch.h), before the heuristic is used
+        virtual const Meeple& selectOpponentsMeeple(const GameState& gameState);
+        virtual BoardPos selectMeeplePosition(const GameState& gameState, const Meeple& meepleToSet);
+
+        virtual void printStatistics(std::ostream& output) const;
+
+        //Compares the lookup tables with the original calculation for every line with 0-3 meeples, every meepleToSet and every opponent's bag
+        //Prints the mismatches and returns their number (see the benchmark suite "smarttables")
+        unsigned int checkLineTables(std::ostream& output) const;
 };
\ No newline at end of file
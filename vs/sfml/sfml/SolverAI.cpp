@@ -0,0 +1,417 @@
+#include "SolverAI.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <string.h>
+
+#include "Board.h"
+#include "MeepleBag.h"
+#include "GameState.h"
+#include "Tablebase.h"
+#include "OpeningBook.h"
+
+
+
+SolverAI::SolverAI(const SearchLimits& limits, unsigned int threadCount, unsigned int tableMegaBytes) : 
+    expectedGive(NO_MEEPLE), table(tableMegaBytes), limits(limits), threadCount(threadCount), stopHelpers(false), nodes(0), completedDepth(0), lastScore(0), moveOrdering(true){
+    assert(threadCount >= 1 && threadCount <= SOLVER_MAX_THREADS);
+    expectedPosition = Position::empty();
+}
+
+
+const Meeple& SolverAI::selectOpponentsMeeple(const GameState& gameState){
+    Position position = Position::fromGameState(gameState, nullptr);
+    uint8_t give = expectedGive;
+    if (give == NO_MEEPLE || position != expectedPosition){     //The meeple hasn't been chosen together with the last position (e.g. first turn of the game)
+        give = searchBestMove(position).give;
+    }
+    expectedGive = NO_MEEPLE;
+
+    for (unsigned int i = 0; i < gameState.opponentBag->getMeepleCount(); ++i){
+        if (gameState.opponentBag->getMeeple(i)->getCode() == give){
+            return *gameState.opponentBag->getMeeple(i);
+        }
+    }
+    assert(false);      //the meeple has to be in the opponent's bag
+    return *gameState.opponentBag->getMeeple(0);
+}
+
+BoardPos SolverAI::selectMeeplePosition(const GameState& gameState, const Meeple& meepleToSet){
+    Position position = Position::fromGameState(gameState, &meepleToSet);
+    CompoundMove best = searchBestMove(position);
+    assert(best.field != NO_FIELD);
+
+    //Remember the meeple for the opponent, it has been found by the same search:
+    expectedPosition = position;
+    expectedPosition.setMeeple(best.field, position.meepleToSet);
+    expectedPosition.meepleToSet = NO_MEEPLE;
+    expectedGive = best.give;
+
+    return BoardPos::fromFieldIndex(best.field);
+}
+
+unsigned long long SolverAI::getNodeCount() const{
+    return nodes;
+}
+
+unsigned int SolverAI::getCompletedDepth() const{
+    return completedDepth;
+}
+
+int SolverAI::getScore() const{
+    return lastScore;
+}
+
+const TranspositionTable& SolverAI::getTranspositionTable() const{
+    return table;
+}
+
+void SolverAI::setMoveOrdering(bool enabled){
+    moveOrdering = enabled;
+}
+
+
+
+unsigned int SolverAI::getMaxDepth(const Position& position) const{
+    const unsigned int remainingTurns = FIELD_COUNT - popcount16(position.occupied) + 1;     //+1: choosing the first meeple is a turn without setting a meeple
+    unsigned int maxDepth;
+    if (limits.depth > 0){
+        maxDepth = limits.depth;
+    }else if (limits.moveTime > 0){
+        maxDepth = remainingTurns;
+    }else{
+        maxDepth = (remainingTurns <= SOLVER_EXACT_EMPTY_FIELDS + 1) ? remainingTurns : SOLVER_OPENING_DEPTH;
+    }
+    return (maxDepth > remainingTurns) ? remainingTurns : maxDepth;
+}
+
+
+CompoundMove SolverAI::searchBestMove(const Position& position){
+    CompoundMove bookMove;
+    if (OpeningBook::getGlobal().probe(position, bookMove)){
+        nodes = 0;
+        completedDepth = 0;
+        lastScore = 0;
+        return bookMove;
+    }
+    CompoundMove tablebaseMove;
+    int tablebaseValue;
+    if (Tablebase::getGlobal().probe(position, tablebaseMove, &tablebaseValue)){
+        nodes = 0;
+        completedDepth = 0;
+        lastScore = (tablebaseValue > 0) ? SOLVER_WIN_SCORE + 1 - tablebaseValue : (tablebaseValue < 0 ? -(SOLVER_WIN_SCORE + 1 + tablebaseValue) : 0);
+        return tablebaseMove;
+    }
+
+    timer.restart(limits);
+    table.newSearch();
+    const unsigned int maxDepth = getMaxDepth(position);
+
+    //Start the helpers:
+    Worker workers[SOLVER_MAX_THREADS];
+    for (unsigned int t = 0; t < threadCount; ++t){
+        initWorker(workers[t], t, (t == 0) ? nullptr : &stopHelpers);
+    }
+    stopHelpers.store(false);
+    std::vector<std::thread> helpers;
+    for (unsigned int t = 1; t < threadCount; ++t){
+        helpers.push_back(std::thread([this, &workers, t, &position, maxDepth](){ runHelper(workers[t], position, maxDepth); }));
+    }
+
+    Worker& worker = workers[0];
+    MoveList moves;
+    generateMoves(position, moves, MoveFilter::NO_LOSING_GIVES);
+    assert(moves.count > 0);
+
+    CompoundMove best = moves.moves[0];
+    lastScore = 0;
+    for (unsigned int depth = 1; depth <= maxDepth; ++depth){
+        CompoundMove iterationBest;
+        int score;
+        if (!searchRoot(worker, position, moves, depth, iterationBest, score)){
+            break;          //Time is up
+        }
+        best = iterationBest;
+        lastScore = score;
+        worker.completedDepth = depth;
+        if (score != 0){
+            break;          //The game is decided - a deeper search can't change the result
+        }
+
+        //The best move is searched first in the next iteration:
+        for (unsigned int m = 1; m < moves.count; ++m){
+            if (moves.moves[m].field == best.field && moves.moves[m].give == best.give){
+                moves.moves[m] = moves.moves[0];
+                moves.moves[0] = best;
+                break;
+            }
+        }
+    }
+
+    stopHelpers.store(true);
+    for (std::vector<std::thread>::iterator it = helpers.begin(); it != helpers.end(); ++it){
+        it->join();
+    }
+    nodes = 0;
+    for (unsigned int t = 0; t < threadCount; ++t){
+        nodes += workers[t].nodes;
+    }
+    completedDepth = worker.completedDepth;
+    return best;
+}
+
+void SolverAI::ponder(const Position& position, const std::atomic<bool>& stop){
+    CompoundMove knownMove;
+    if (position.isFull() || position.checkWinSituation() || OpeningBook::getGlobal().probe(position, knownMove) || Tablebase::getGlobal().probe(position, knownMove)){
+        return;
+    }
+    table.newSearch();
+    const unsigned int maxDepth = FIELD_COUNT - popcount16(position.occupied) + 1;      //Until the end of the game, or until stop is set
+
+    //All threads are helpers of a search without a main thread - its move isn't needed:
+    Worker workers[SOLVER_MAX_THREADS];
+    for (unsigned int t = 0; t < threadCount; ++t){
+        initWorker(workers[t], t, &stop);
+    }
+    std::vector<std::thread> helpers;
+    for (unsigned int t = 1; t < threadCount; ++t){
+        helpers.push_back(std::thread([this, &workers, t, &position, maxDepth](){ runHelper(workers[t], position, maxDepth); }));
+    }
+    runHelper(workers[0], position, maxDepth);
+    for (std::vector<std::thread>::iterator it = helpers.begin(); it != helpers.end(); ++it){
+        it->join();
+    }
+}
+
+void SolverAI::initWorker(Worker& worker, unsigned int index, const std::atomic<bool>* stop){
+    worker.index = index;
+    worker.nodes = 0;
+    worker.aborted = false;
+    worker.completedDepth = 0;
+    worker.stop = stop;
+    memset(worker.killers, NO_FIELD, sizeof(worker.killers));         //NO_FIELD = NO_MEEPLE: no move
+    memset(worker.history, 0, sizeof(worker.history));
+}
+
+void SolverAI::runHelper(Worker& worker, const Position& position, unsigned int maxDepth){
+    MoveList moves;
+    generateMoves(position, moves, MoveFilter::NO_LOSING_GIVES);
+
+    //Each helper starts with other root moves, and every second helper is one iteration ahead --> the threads search different parts of the tree
+    std::rotate(moves.moves, moves.moves + worker.index % moves.count, moves.moves + moves.count);
+    for (unsigned int depth = 1 + worker.index % 2; depth <= maxDepth; ++depth){
+        CompoundMove best;
+        int score;
+        if (!searchRoot(worker, position, moves, depth, best, score) || score != 0){
+            break;
+        }
+        worker.completedDepth = depth;
+    }
+}
+
+bool SolverAI::searchRoot(Worker& worker, const Position& position, MoveList& moves, unsigned int depth, CompoundMove& best, int& bestScore){
+    Position current = position;
+    const uint64_t hash = position.getHash();
+    best = moves.moves[0];
+    bestScore = -SOLVER_WIN_SCORE - 1;
+    unsigned int randMod = 2;       //Moves with the same score are chosen randomly (with the same probability for each move; only the main thread of a decision uses rand())
+    for (unsigned int m = 0; m < moves.count; ++m){
+        const CompoundMove& move = moves.moves[m];
+        int score;
+        makeMove(current, move);
+        if (move.give == NO_MEEPLE){        //The game is over
+            score = current.checkWinSituation() ? SOLVER_WIN_SCORE : 0;
+        }else{
+            score = -search(worker, current, getHashAfterMove(hash, position, move), depth - 1, 1, -SOLVER_WIN_SCORE - 1, -bestScore + 1);     //The window includes the best score, to find all moves with the same score
+        }
+        unmakeMove(current, move);
+        if (worker.aborted){
+            return false;
+        }
+
+        if (score > bestScore){
+            bestScore = score;
+            best = move;
+            randMod = 2;
+        }else if (score == bestScore && worker.stop == nullptr && (rand() % (randMod++)) == 0){
+            best = move;
+        }
+    }
+    assert(current == position);
+    return true;
+}
+
+
+static bool isSameMove(const CompoundMove& lhs, const CompoundMove& rhs){
+    return lhs.field == rhs.field && lhs.give == rhs.give;
+}
+
+static unsigned int getHistoryField(const CompoundMove& move){
+    return (move.field != NO_FIELD) ? move.field : FIELD_COUNT;
+}
+
+//Moves the move with the highest score of the moves from index on to the index (a selection sort, which stops at the first cutoff)
+static void selectNextMove(MoveList& moves, uint32_t* scores, unsigned int index){
+    unsigned int best = index;
+    for (unsigned int m = index + 1; m < moves.count; ++m){
+        if (scores[m] > scores[best]){
+            best = m;
+        }
+    }
+    if (best != index){
+        std::swap(moves.moves[index], moves.moves[best]);
+        std::swap(scores[index], scores[best]);
+    }
+}
+
+
+//Wins are stored relative to the position (turns until the win), since the same position can be reached at different plies
+static int16_t scoreToTable(int score, unsigned int ply){
+    return static_cast<int16_t>(score > 0 ? score + static_cast<int>(ply) : (score < 0 ? score - static_cast<int>(ply) : 0));
+}
+
+static int scoreFromTable(int16_t score, unsigned int ply){
+    return score > 0 ? score - static_cast<int>(ply) : (score < 0 ? score + static_cast<int>(ply) : 0);
+}
+
+
+int SolverAI::search(Worker& worker, Position& position, uint64_t hash, unsigned int depth, unsigned int ply, int alpha, int beta){
+    assert(hash == position.getHash());
+    if ((++worker.nodes & (SOLVER_TIME_CHECK_INTERVAL - 1)) == 0){
+        if (worker.stop == nullptr){
+            worker.aborted = worker.completedDepth > 0 && timer.isExpired();      //The first iteration always completes, to have a move
+        }else{
+            worker.aborted = worker.stop->load(std::memory_order_relaxed);
+        }
+    }
+    if (worker.aborted){
+        return 0;
+    }
+    MoveList moves;
+    if (position.meepleToSet != NO_MEEPLE){
+        generateMoves(position, moves, MoveFilter::WINS_ONLY);
+        if (moves.count > 0){
+            return SOLVER_WIN_SCORE - static_cast<int>(ply);
+        }
+    }
+    if (depth == 0){
+        return 0;       //Unknown outcome
+    }
+
+    //A search, which reaches the end of the game, is exact - no matter how much deeper it could have gone:
+    const unsigned int remainingTurns = FIELD_COUNT - popcount16(position.occupied) + 1;
+    if (depth > remainingTurns){
+        depth = remainingTurns;
+    }
+
+    TTEntry entry;
+    CompoundMove tableMove = { NO_FIELD, NO_MEEPLE };
+    if (table.probe(hash, entry)){
+        if (entry.depth >= depth){
+            int score = scoreFromTable(entry.score, ply);
+            if (entry.bound == TTBound::EXACT || (entry.bound == TTBound::LOWER && score >= beta) || (entry.bound == TTBound::UPPER && score <= alpha)){
+                return score;
+            }
+        }
+        tableMove.field = entry.field;
+        tableMove.give = entry.give;
+    }
+
+    generateMoves(position, moves, MoveFilter::NO_LOSING_GIVES);       //Losing gives can be skipped: they are never better than any other give
+    assert(moves.count > 0);
+    //At depth 1, the children are leaves with the same score (no win, since losing gives are skipped) --> the order doesn't matter there
+    uint32_t orderScores[MAX_COMPOUND_MOVES];
+    const bool orderedMoves = moveOrdering && depth >= 2;
+    if (orderedMoves){
+        orderMoves(worker, moves, tableMove, ply, orderScores);
+    }else{
+        //Only the best move of an earlier search is tried first (if it is still in the list - the hash might belong to another position):
+        for (unsigned int m = 1; m < moves.count; ++m){
+            if (isSameMove(moves.moves[m], tableMove)){
+                std::swap(moves.moves[0], moves.moves[m]);
+                break;
+            }
+        }
+    }
+
+    const int originalAlpha = alpha;
+    int best = -SOLVER_WIN_SCORE - 1;
+    CompoundMove bestMove = moves.moves[0];
+    for (unsigned int m = 0; m < moves.count; ++m){
+        if (orderedMoves){
+            selectNextMove(moves, orderScores, m);
+        }
+        const CompoundMove& move = moves.moves[m];
+        int score;
+        if (move.give == NO_MEEPLE){        //No win (checked above) --> the board is full, it's a tie
+            score = 0;
+        }else{
+            const uint64_t childHash = getHashAfterMove(hash, position, move);
+            makeMove(position, move);
+            score = -search(worker, position, childHash, depth - 1, ply + 1, -beta, -alpha);
+            unmakeMove(position, move);
+            if (worker.aborted){
+                return 0;   //The result is incomplete - don't store it
+            }
+        }
+
+        if (score > best){
+            best = score;
+            bestMove = move;
+            if (score > alpha){
+                alpha = score;
+                if (alpha >= beta){
+                    if (moveOrdering){
+                        updateOrdering(worker, move, depth, ply);
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    entry.score = scoreToTable(best, ply);
+    entry.depth = static_cast<uint8_t>(depth);
+    entry.bound = static_cast<uint8_t>(best <= originalAlpha ? TTBound::UPPER : (best >= beta ? TTBound::LOWER : TTBound::EXACT));
+    entry.field = bestMove.field;
+    entry.give = bestMove.give;
+    table.store(hash, entry);
+    return best;
+}
+
+
+void SolverAI::orderMoves(const Worker& worker, const MoveList& moves, const CompoundMove& tableMove, unsigned int ply, uint32_t* scores) const{
+    const uint32_t TABLE_MOVE_SCORE = 0xFFFFFFFF;
+    const uint32_t KILLER_SCORE = 0xFFFFFFFD;           //-1 for the second killer; the history scores are lower (see SOLVER_HISTORY_LIMIT)
+    for (unsigned int m = 0; m < moves.count; ++m){
+        const CompoundMove& move = moves.moves[m];
+        if (isSameMove(move, tableMove)){
+            scores[m] = TABLE_MOVE_SCORE;
+        }else if (isSameMove(move, worker.killers[ply][0])){
+            scores[m] = KILLER_SCORE;
+        }else if (isSameMove(move, worker.killers[ply][1])){
+            scores[m] = KILLER_SCORE - 1;
+        }else{
+            scores[m] = worker.history[getHistoryField(move)][move.give != NO_MEEPLE ? move.give : 0];
+        }
+    }
+}
+
+void SolverAI::updateOrdering(Worker& worker, const CompoundMove& move, unsigned int depth, unsigned int ply){
+    if (!isSameMove(move, worker.killers[ply][0])){
+        worker.killers[ply][1] = worker.killers[ply][0];
+        worker.killers[ply][0] = move;
+    }
+    uint32_t& history = worker.history[getHistoryField(move)][move.give != NO_MEEPLE ? move.give : 0];
+    history += depth * depth;
+    if (history > SOLVER_HISTORY_LIMIT){
+        for (unsigned int f = 0; f <= FIELD_COUNT; ++f){
+            for (unsigned int c = 0; c < 16; ++c){
+                worker.history[f][c] /= 2;
+            }
+        }
+    }
+}
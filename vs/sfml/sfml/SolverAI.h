@@ -0,0 +1,82 @@
+#pragma once
+#include <cstdint>
+#include <atomic>
+
+#include "I_AI.h"
+#include "Position.h"
+#include "MoveGenerator.h"
+#include "TranspositionTable.h"
+#include "SearchLimits.h"
+
+
+//Default limits (if neither a depth nor a move time is given):
+#define SOLVER_EXACT_EMPTY_FIELDS 10    //Positions with up to this number of empty fields are solved exactly (until the end of the game)
+#define SOLVER_OPENING_DEPTH 2          //Number of turns, which are searched in positions with more empty fields (outcomes behind this horizon count as a tie)
+
+#define SOLVER_TIME_CHECK_INTERVAL 1024 //The deadline is checked every this many nodes (must be a power of 2)
+#define SOLVER_WIN_SCORE 100            //Score of a win in the current turn; each turn until the win costs 1 point (faster wins are better)
+#define SOLVER_TABLE_MEGABYTES 16       //Default size of the transposition table
+#define SOLVER_MAX_THREADS 64          //Max. number of search threads (Lazy SMP)
+#define SOLVER_MAX_PLIES (FIELD_COUNT + 2)      //Max. ply of the search (the first turn only chooses a meeple)
+#define SOLVER_HISTORY_LIMIT (1 << 24)  //The history scores are halved, when one of them exceeds this value
+
+
+//This AI searches the game tree with negamax and alpha-beta pruning over compound moves (set the meeple + choose a meeple for the opponent)
+//The search works in-place on a single Position (makeMove/unmakeMove), so it doesn't need to clone the GameState or allocate any memory
+//Searched positions are stored in a transposition table, which is kept between the moves (and games)
+//Positions in the opening book or the endgame tablebase (see OpeningBook.h, Tablebase.h) aren't searched at all
+//The search uses iterative deepening (depth 1, 2, ...) within the SearchLimits; the best move of the last completed iteration is played
+//Move ordering: the move from the transposition table first, then the 2 killer moves of the ply (recent moves with a beta cutoff in sibling nodes),
+//  then the moves with the highest history score (depth^2 for each cutoff of the compound move (field, give) anywhere in the tree)
+//  Wins are found before the moves are generated, and gives, which let the opponent win immediately, are skipped (see MoveFilter::NO_LOSING_GIVES)
+//Lazy SMP: with more than 1 thread, helper threads search the same position at staggered depths; they only share the transposition table
+//  (the helpers fill it with results, which the main thread finds later), the move is always the result of the main thread
+//Pondering: during the opponent's turn, all threads search the opponent's position like helpers; the transposition table keeps the results
+//  for the positions after the opponent's move, so the iterations of the next decision are mostly table hits
+class SolverAI : public I_AI{
+private:
+    Position expectedPosition;          //The position after setting the meeple in the last selectMeeplePosition() call (the opponent's meeple isn't chosen yet)
+    uint8_t expectedGive;               //The best meeple for the opponent in expectedPosition (found by the same search); NO_MEEPLE if there is none
+    TranspositionTable table;
+    const SearchLimits limits;
+    const unsigned int threadCount;     //Number of search threads (including the calling thread)
+    SearchTimer timer;
+    std::atomic<bool> stopHelpers;      //Set by the main thread, when its search is finished
+    unsigned long long nodes;           //Number of searched positions of all threads in the last search
+    unsigned int completedDepth;        //Depth of the last completed iteration of the main thread in the last search
+    int lastScore;                      //Score of the last search (see getScore())
+
+    struct Worker{                      //State of one search thread
+        unsigned int index;             //0 = main thread (the calling thread)
+        unsigned long long nodes;
+        bool aborted;                   //true, if the search has to stop (time is up, or the main thread is finished); the results of the current iteration are discarded
+        unsigned int completedDepth;
+        const std::atomic<bool>* stop;  //The flag, which ends the search (helpers: stopHelpers; pondering: the caller's flag); nullptr: the deadline of the timer
+        CompoundMove killers[SOLVER_MAX_PLIES][2];             //Per ply: the last 2 moves with a beta cutoff (the newest first)
+        uint32_t history[FIELD_COUNT + 1][16];                  //Per compound move [field (FIELD_COUNT: no field)][give]: score of its cutoffs
+    };
+    bool moveOrdering;                  //false: only the move from the transposition table is moved to the front (for comparisons)
+
+
+    unsigned int getMaxDepth(const Position& position) const;                  //Last iteration of the search within the limits
+    void runHelper(Worker& worker, const Position& position, unsigned int maxDepth);
+    bool searchRoot(Worker& worker, const Position& position, MoveList& moves, unsigned int depth, CompoundMove& best, int& bestScore);   //One iteration: searches all moves to the depth; returns false, if the iteration has been aborted
+    int search(Worker& worker, Position& position, uint64_t hash, unsigned int depth, unsigned int ply, int alpha, int beta);           //Negamax: returns the score of the position (hash = its Zobrist-hash) for position.sideToMove
+    static void initWorker(Worker& worker, unsigned int index, const std::atomic<bool>* stop);
+    void orderMoves(const Worker& worker, const MoveList& moves, const CompoundMove& tableMove, unsigned int ply, uint32_t* scores) const;    //Order scores of the moves (see selectNextMove())
+    static void updateOrdering(Worker& worker, const CompoundMove& move, unsigned int depth, unsigned int ply);                         //The move caused a beta cutoff
+
+public:
+    explicit SolverAI(const SearchLimits& limits = SearchLimits(), unsigned int threadCount = 1, unsigned int tableMegaBytes = SOLVER_TABLE_MEGABYTES);
+
+    virtual const Meeple& selectOpponentsMeeple(const GameState& gameState);
+    virtual BoardPos selectMeeplePosition(const GameState& gameState, const Meeple& meepleToSet);
+    virtual void ponder(const Position& position, const std::atomic<bool>& stop);
+
+    CompoundMove searchBestMove(const Position& position);     //Searches all moves of the position, and returns the best one
+    unsigned long long getNodeCount() const;                    //Number of positions, which have been searched for the last decision
+    unsigned int getCompletedDepth() const;                     //Depth of the last completed iteration of the last decision
+    int getScore() const;                                       //Score of the last decision for the side to move: SOLVER_WIN_SCORE - turns until a win, -(SOLVER_WIN_SCORE - turns) until a loss, 0: tie (or unknown)
+    const TranspositionTable& getTranspositionTable() const;
+    void setMoveOrdering(bool enabled);                         //Enables the killer and history heuristics (default: enabled)
+};
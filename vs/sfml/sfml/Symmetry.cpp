@@ -0,0 +1,277 @@
+#include "Symmetry.h"
+
+#include <assert.h>
+
+#include "Meeple.h"
+
+
+//All permutations p of the coordinates [0-3], which commute with the mirroring m(i) = 3 - i --> (x, y) --> (p(x), p(y)) keeps both diagonals
+static const uint8_t SYMMETRY_COORD_PERMUTATIONS[8][4] = {
+    { 0, 1, 2, 3 }, { 3, 2, 1, 0 }, { 0, 2, 1, 3 }, { 3, 1, 2, 0 },
+    { 1, 0, 3, 2 }, { 2, 3, 0, 1 }, { 1, 3, 0, 2 }, { 2, 0, 3, 1 }
+};
+
+#define GEOMETRY_MIRROR_Y 0x08
+#define GEOMETRY_TRANSPOSE 0x10
+
+
+//Lookup tables, filled once at startup (VS2013 doesn't support constexpr)
+struct SymmetryTables{
+    uint16_t lowByte[GEOMETRY_COUNT][256];      //[geometry][fields 0-7]: transformed fields
+    uint16_t highByte[GEOMETRY_COUNT][256];     //[geometry][fields 8-15]: transformed fields
+    uint8_t fieldMap[GEOMETRY_COUNT][FIELD_COUNT];
+    uint8_t fieldUnmap[GEOMETRY_COUNT][FIELD_COUNT];
+    uint8_t codeMap[PROPERTY_COUNT][PROPERTY_COUNT][16];   //[propertyOrder[1]][propertyOrder[2]][complemented code]: transformed code (propertyOrder[3] is the remaining property)
+    uint8_t codeUnmap[PROPERTY_COUNT][PROPERTY_COUNT][16]; //[propertyOrder[1]][propertyOrder[2]][transformed code]: complemented code
+
+    SymmetryTables();
+};
+static const SymmetryTables TABLES;
+
+
+static inline uint16_t transformFields(uint16_t fields, uint8_t geometry){
+    return static_cast<uint16_t>(TABLES.lowByte[geometry][fields & 0xFF] | TABLES.highByte[geometry][fields >> 8]);
+}
+
+
+static uint16_t transposeFields(uint16_t fields){      //(x, y) --> (y, x) with 2 delta-swaps
+    uint16_t t = (fields ^ (fields >> 3)) & 0x0A0A;
+    fields = static_cast<uint16_t>(fields ^ t ^ (t << 3));
+    t = (fields ^ (fields >> 6)) & 0x00CC;
+    return static_cast<uint16_t>(fields ^ t ^ (t << 6));
+}
+
+static uint16_t calculateTransformedFields(uint16_t fields, uint8_t geometry, const uint8_t rowNibble[8][16], const uint8_t rowTarget[16][4]){     //only used to fill the tables
+    if (geometry & GEOMETRY_TRANSPOSE){
+        fields = transposeFields(fields);
+    }
+    const uint8_t* nibble = rowNibble[geometry & 7];
+    const uint8_t* target = rowTarget[geometry & 15];
+    return static_cast<uint16_t>(
+        (nibble[fields & 0xF] << (4 * target[0])) |
+        (nibble[(fields >> 4) & 0xF] << (4 * target[1])) |
+        (nibble[(fields >> 8) & 0xF] << (4 * target[2])) |
+        (nibble[fields >> 12] << (4 * target[3])));
+}
+
+SymmetryTables::SymmetryTables(){
+    uint8_t rowNibble[8][16];                   //[permutation][4 bits of a row]: permuted row
+    uint8_t rowTarget[16][4];                   //[geometry & 15][y]: target row of row y
+    for (uint8_t p = 0; p < 8; ++p){
+        for (uint8_t row = 0; row < 16; ++row){
+            rowNibble[p][row] = 0;
+            for (uint8_t x = 0; x < 4; ++x){
+                if (row & (1 << x)){
+                    rowNibble[p][row] |= static_cast<uint8_t>(1 << SYMMETRY_COORD_PERMUTATIONS[p][x]);
+                }
+            }
+        }
+    }
+    for (uint8_t g = 0; g < 16; ++g){
+        for (uint8_t y = 0; y < 4; ++y){
+            uint8_t target = SYMMETRY_COORD_PERMUTATIONS[g & 7][y];
+            rowTarget[g][y] = (g & GEOMETRY_MIRROR_Y) ? static_cast<uint8_t>(3 - target) : target;
+        }
+    }
+    for (uint8_t g = 0; g < GEOMETRY_COUNT; ++g){
+        for (uint8_t f = 0; f < FIELD_COUNT; ++f){
+            uint8_t mapped = lowestBitIndex(calculateTransformedFields(static_cast<uint16_t>(1 << f), g, rowNibble, rowTarget));
+            fieldMap[g][f] = mapped;
+            fieldUnmap[g][mapped] = f;
+        }
+        for (unsigned int byte = 0; byte < 256; ++byte){
+            lowByte[g][byte] = calculateTransformedFields(static_cast<uint16_t>(byte), g, rowNibble, rowTarget);
+            highByte[g][byte] = calculateTransformedFields(static_cast<uint16_t>(byte << 8), g, rowNibble, rowTarget);
+        }
+    }
+    for (uint8_t a = 1; a < PROPERTY_COUNT; ++a){
+        for (uint8_t b = 1; b < PROPERTY_COUNT; ++b){
+            if (a == b){
+                continue;
+            }
+            const uint8_t order[PROPERTY_COUNT] = { 0, a, b, static_cast<uint8_t>(6 - a - b) };
+            for (uint8_t code = 0; code < 16; ++code){
+                uint8_t mapped = 0;
+                for (uint8_t i = 0; i < PROPERTY_COUNT; ++i){
+                    mapped |= static_cast<uint8_t>(((code >> order[i]) & 1) << i);
+                }
+                codeMap[a][b][code] = mapped;
+                codeUnmap[a][b][mapped] = code;
+            }
+        }
+    }
+}
+
+
+
+SymmetryTransform SymmetryTransform::identity(){
+    SymmetryTransform transform = { 0, 0, { 0, 1, 2, 3 } };
+    return transform;
+}
+
+uint8_t SymmetryTransform::mapField(uint8_t field) const{
+    assert(field < FIELD_COUNT && geometry < GEOMETRY_COUNT);
+    return TABLES.fieldMap[geometry][field];
+}
+
+uint8_t SymmetryTransform::unmapField(uint8_t field) const{
+    assert(field < FIELD_COUNT && geometry < GEOMETRY_COUNT);
+    return TABLES.fieldUnmap[geometry][field];
+}
+
+uint16_t SymmetryTransform::mapFields(uint16_t fields) const{
+    return transformFields(fields, geometry);
+}
+
+uint8_t SymmetryTransform::mapCode(uint8_t code) const{
+    assert(code < 16 && propertyOrder[0] == 0 && propertyOrder[1] + propertyOrder[2] + propertyOrder[3] == 6);
+    return TABLES.codeMap[propertyOrder[1]][propertyOrder[2]][code ^ codeXor];
+}
+
+uint8_t SymmetryTransform::unmapCode(uint8_t code) const{
+    assert(code < 16);
+    return static_cast<uint8_t>(TABLES.codeUnmap[propertyOrder[1]][propertyOrder[2]][code] ^ codeXor);
+}
+
+uint16_t SymmetryTransform::mapCodes(uint16_t codes) const{
+    uint16_t result = 0;
+    for (; codes != 0; codes &= codes - 1){
+        result |= static_cast<uint16_t>(1 << mapCode(lowestBitIndex(codes)));
+    }
+    return result;
+}
+
+Position SymmetryTransform::apply(const Position& position) const{
+    Position result = { 0, mapFields(position.occupied), mapCodes(position.available), static_cast<uint8_t>(position.sideToMove ^ (codeXor & 1)), NO_MEEPLE };
+    for (uint16_t fields = position.occupied; fields != 0; fields &= fields - 1){
+        uint8_t field = lowestBitIndex(fields);
+        result.cells |= static_cast<uint64_t>(mapCode(position.getMeepleCode(field))) << (4 * mapField(field));
+    }
+    if (position.meepleToSet != NO_MEEPLE){
+        result.meepleToSet = mapCode(position.meepleToSet);
+    }
+    return result;
+}
+
+
+
+SymmetryTransform canonicalize(const Position& position, Position& canonical){
+    //The board as bitboards: occupied fields + one plane per property (bit f of plane p = bit p of the code on field f)
+    uint16_t planes[PROPERTY_COUNT] = { 0, 0, 0, 0 };
+    for (uint16_t fields = position.occupied; fields != 0; fields &= fields - 1){
+        uint8_t field = lowestBitIndex(fields);
+        uint8_t code = position.getMeepleCode(field);
+        for (uint8_t p = 0; p < PROPERTY_COUNT; ++p){
+            planes[p] |= static_cast<uint16_t>(((code >> p) & 1) << field);
+        }
+    }
+    const uint8_t colorXor = (position.sideToMove == MeepleColor::BLACK) ? 1 : 0;     //The canonical position is always white's turn
+
+    //Try all geometries. For each geometry:
+    //  1. complement the properties, so that the reference meeple (meepleToSet, or the meeple on the first occupied field) gets the code 0 (except the color)
+    //  2. sort the property planes (= best permutation)
+    //The complements/permutations only depend on the transformed board, so the smallest (occupied, planes, available) of all geometries is the same for all symmetric positions
+    SymmetryTransform best = SymmetryTransform::identity();
+    uint16_t bestKey[PROPERTY_COUNT + 2];
+    bool found = false;
+
+    //In a real game, the available meeples are all meeples, which are neither on the board nor the meepleToSet. Then they are the same for all candidates with the same board, and don't need to be compared
+    uint16_t naturalBag = 0xFFFF;
+    for (uint16_t fields = position.occupied; fields != 0; fields &= fields - 1){
+        naturalBag &= static_cast<uint16_t>(~(1 << position.getMeepleCode(lowestBitIndex(fields))));
+    }
+    if (position.meepleToSet != NO_MEEPLE){
+        naturalBag &= static_cast<uint16_t>(~(1 << position.meepleToSet));
+    }
+    const bool compareBags = (position.available != naturalBag);
+    const uint8_t geometryCount = (position.occupied == 0) ? 1 : GEOMETRY_COUNT;    //An empty board looks the same in all geometries
+
+    for (uint8_t g = 0; g < geometryCount; ++g){
+        uint16_t key[PROPERTY_COUNT + 2];       //occupied, planes (in the canonical order), available
+        key[0] = transformFields(position.occupied, g);
+        if (found && key[0] > bestKey[0]){
+            continue;           //most geometries can be rejected by the occupied fields alone
+        }
+        uint16_t transformed[PROPERTY_COUNT];
+        for (uint8_t p = 0; p < PROPERTY_COUNT; ++p){
+            transformed[p] = transformFields(planes[p], g);
+        }
+
+        uint8_t codeXor = colorXor;
+        uint8_t complementCount = 1;            //Number of complements to try: without a reference meeple (empty board), all complements of size/shape/detail are equal for the board - only the available meeples decide
+        if (position.meepleToSet != NO_MEEPLE){
+            codeXor |= position.meepleToSet & 0xE;
+        }else if (key[0] != 0){
+            uint8_t reference = lowestBitIndex(key[0]);
+            for (uint8_t p = 1; p < PROPERTY_COUNT; ++p){
+                codeXor |= static_cast<uint8_t>(((transformed[p] >> reference) & 1) << p);
+            }
+        }else{
+            complementCount = 8;
+        }
+        for (uint8_t p = 0; p < PROPERTY_COUNT; ++p){
+            if (codeXor & (1 << p)){
+                transformed[p] ^= key[0];
+            }
+        }
+
+        //sort the planes 1-3 (color stays at 0):
+        uint8_t order[PROPERTY_COUNT] = { 0, 1, 2, 3 };
+        for (uint8_t i = 2; i < PROPERTY_COUNT; ++i){
+            for (uint8_t j = i; j > 1 && transformed[order[j]] < transformed[order[j - 1]]; --j){
+                uint8_t tmp = order[j];
+                order[j] = order[j - 1];
+                order[j - 1] = tmp;
+            }
+        }
+        for (uint8_t p = 0; p < PROPERTY_COUNT; ++p){
+            key[p + 1] = transformed[order[p]];
+        }
+
+        //compare the board first - the available meeples are only needed, if the board is a candidate:
+        int cmp = 0;
+        for (uint8_t k = 0; found && cmp == 0 && k <= PROPERTY_COUNT; ++k){
+            cmp = (key[k] < bestKey[k]) ? -1 : (key[k] > bestKey[k]) ? 1 : 0;
+        }
+        if (cmp > 0){
+            continue;
+        }
+
+        if (!compareBags){
+            if (!found || cmp < 0){
+                SymmetryTransform candidate = { g, codeXor, { order[0], order[1], order[2], order[3] } };
+                for (uint8_t k = 0; k <= PROPERTY_COUNT; ++k){
+                    bestKey[k] = key[k];
+                }
+                best = candidate;
+                found = true;
+            }
+            continue;
+        }
+
+        //Equal planes can be permuted without changing the board, but they might change the available meeples --> try all orders with the same planes
+        static const uint8_t PROPERTY_PERMUTATIONS[6][3] = { { 1, 2, 3 }, { 1, 3, 2 }, { 2, 1, 3 }, { 2, 3, 1 }, { 3, 1, 2 }, { 3, 2, 1 } };
+        for (uint8_t complement = 0; complement < complementCount; ++complement){
+            for (uint8_t perm = 0; perm < 6; ++perm){
+                SymmetryTransform candidate = { g, static_cast<uint8_t>(codeXor | (complement << 1)), { 0, PROPERTY_PERMUTATIONS[perm][0], PROPERTY_PERMUTATIONS[perm][1], PROPERTY_PERMUTATIONS[perm][2] } };
+                if (transformed[candidate.propertyOrder[1]] != key[2] || transformed[candidate.propertyOrder[2]] != key[3] || transformed[candidate.propertyOrder[3]] != key[4]){
+                    continue;
+                }
+                key[PROPERTY_COUNT + 1] = candidate.mapCodes(position.available);
+                if (!found || cmp < 0 || key[PROPERTY_COUNT + 1] < bestKey[PROPERTY_COUNT + 1]){
+                    for (uint8_t k = 0; k < PROPERTY_COUNT + 2; ++k){
+                        bestKey[k] = key[k];
+                    }
+                    best = candidate;
+                    found = true;
+                    cmp = 0;
+                }
+            }
+        }
+    }
+
+    canonical = best.apply(position);
+    assert(canonical.sideToMove == MeepleColor::WHITE);
+    assert(canonical.occupied == bestKey[0] && (!compareBags || canonical.available == bestKey[PROPERTY_COUNT + 1]));
+    return best;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+
+#include "Bitboard.h"
+#include "Position.h"
+
+
+//Symmetries of the game: transformations, which don't change the value of a position
+//  - geometry: 32 transformations of the board, which map every row/column/diagonal onto a row/column/diagonal (see SymmetryTransform::geometry)
+//  - properties: size, shape and detail can be permuted, and each of them can be complemented (big <--> small, ...)
+//  - color: is also the owner of a meeple (a player can only choose meeples from the opponent's bag) - it can't be permuted with the other properties, but it can be complemented together with sideToMove
+#define GEOMETRY_COUNT 32
+
+
+//A single symmetry: maps an (original) position onto an equivalent position
+struct SymmetryTransform{
+    uint8_t geometry;                           //bits 0-2: permutation of the coordinates (see SYMMETRY_COORD_PERMUTATIONS), bit 3: the y-coordinate is mirrored as well, bit 4: transposed before the permutation
+    uint8_t codeXor;                            //Mask of the complemented properties (applied to the original code, before the permutation)
+    uint8_t propertyOrder[PROPERTY_COUNT];      //Bit i of the transformed code is bit propertyOrder[i] of the complemented code (propertyOrder[0] is always 0)
+
+    static SymmetryTransform identity();
+
+    uint8_t mapField(uint8_t field) const;      //original field --> transformed field
+    uint8_t unmapField(uint8_t field) const;    //transformed field --> original field
+    uint16_t mapFields(uint16_t fields) const;  //Transforms a bitboard
+    uint8_t mapCode(uint8_t code) const;        //original meeple code --> transformed meeple code
+    uint8_t unmapCode(uint8_t code) const;      //transformed meeple code --> original meeple code
+    uint16_t mapCodes(uint16_t codes) const;    //Transforms a mask over the meeple codes (e.g. Position::available)
+
+    Position apply(const Position& position) const;     //Returns the transformed position
+};
+
+
+//Maps the position (see Position::fromGameState()) onto the canonical representative of all its symmetric positions (same result for all positions, which are symmetric to each other)
+//Returns the transformation from position to canonical; use unmapField()/unmapCode() to translate moves of the canonical position back
+//The canonical position has always sideToMove = WHITE (and meepleToSet = 0, if a meeple has to be set)
+SymmetryTransform canonicalize(const Position& position, Position& canonical);
@@ -0,0 +1,240 @@
+#include "Tablebase.h"
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+#include <unordered_map>
+#include <chrono>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "Meeple.h"
+#include "Symmetry.h"
+#include "SolverAI.h"
+
+
+
+static uint64_t getSlot(uint64_t key, uint64_t capacity){          //First slot of the key (linear probing from there)
+    return ((key * 0x9E3779B97F4A7C15ULL) >> 32) & (capacity - 1);
+}
+
+//Converts a TablebaseEntry::value into a score, which is higher for better results (faster wins, slower losses)
+static int getValueScore(int value){
+    return (value > 0) ? 1000 - value : (value < 0 ? -1000 - value : 0);
+}
+
+//Converts the score of a SolverAI (see SOLVER_WIN_SCORE) into a TablebaseEntry::value
+static int8_t getSolverValue(int score){
+    if (score > 0){
+        return static_cast<int8_t>(SOLVER_WIN_SCORE - score + 1);
+    }
+    if (score < 0){
+        return static_cast<int8_t>(-(SOLVER_WIN_SCORE + score + 1));
+    }
+    return 0;
+}
+
+
+
+static Tablebase globalTablebase;
+
+Tablebase& Tablebase::getGlobal(){
+    return globalTablebase;
+}
+
+
+Tablebase::Tablebase() : header(nullptr), entries(nullptr){
+}
+
+bool Tablebase::load(const std::string& path){
+    unload();
+    if (!file.open(path)){
+        return false;
+    }
+    const TablebaseHeader* fileHeader = reinterpret_cast<const TablebaseHeader*>(file.getData());
+    if (file.getSize() < sizeof(TablebaseHeader) || memcmp(fileHeader->magic, "4WTB", 4) != 0 || fileHeader->version != TABLEBASE_VERSION
+        || fileHeader->capacity == 0 || (fileHeader->capacity & (fileHeader->capacity - 1)) != 0
+        || file.getSize() != sizeof(TablebaseHeader) + fileHeader->capacity * sizeof(TablebaseEntry)){
+        std::cout << "The tablebase " << path << " is invalid, it is ignored" << std::endl;
+        file.close();
+        return false;
+    }
+    header = fileHeader;
+    entries = reinterpret_cast<const TablebaseEntry*>(file.getData() + sizeof(TablebaseHeader));
+    return true;
+}
+
+void Tablebase::unload(){
+    file.close();
+    header = nullptr;
+    entries = nullptr;
+}
+
+bool Tablebase::isLoaded() const{
+    return header != nullptr;
+}
+
+unsigned int Tablebase::getMaxEmptyFields() const{
+    return isLoaded() ? header->maxEmptyFields : 0;
+}
+
+uint64_t Tablebase::getEntryCount() const{
+    return isLoaded() ? header->entryCount : 0;
+}
+
+
+const TablebaseEntry* Tablebase::find(uint64_t key) const{
+    assert(isLoaded() && key != 0);
+    const uint64_t mask = header->capacity - 1;
+    for (uint64_t slot = getSlot(key, header->capacity); entries[slot].key != 0; slot = (slot + 1) & mask){
+        if (entries[slot].key == key){
+            return &entries[slot];
+        }
+    }
+    return nullptr;
+}
+
+bool Tablebase::probe(const Position& position, CompoundMove& move, int* value) const{
+    if (!isLoaded() || static_cast<unsigned int>(FIELD_COUNT - popcount16(position.occupied)) > header->maxEmptyFields){
+        return false;
+    }
+
+    if (position.meepleToSet != NO_MEEPLE){
+        //The key only identifies positions of real games (every meeple, which isn't on the board or the meepleToSet, is available):
+        if (popcount16(position.occupied) + popcount16(position.available) + 1 != 16){
+            return false;
+        }
+        Position canonical;
+        SymmetryTransform transform = canonicalize(position, canonical);
+        const TablebaseEntry* entry = find(canonical.cells);
+        if (entry == nullptr){
+            return false;
+        }
+        move.field = transform.unmapField(entry->field);
+        move.give = (entry->give != NO_MEEPLE) ? transform.unmapCode(entry->give) : static_cast<uint8_t>(NO_MEEPLE);
+        if (value != nullptr){
+            *value = entry->value;
+        }
+        return true;
+    }
+
+    //Only a meeple has to be chosen: each meeple leads to a position of the opponent, the worst one for the opponent is the best one
+    const uint16_t gives = position.available & MEEPLE_PROPERTY_MASKS[getPropertyPlaneIndex(MeepleProperty::MEEPLE_COLOR, position.sideToMove ^ 1)];
+    const uint16_t winningCodes = getWinningCodes(position);
+    int bestValue = 0;
+    move.field = NO_FIELD;
+    move.give = NO_MEEPLE;
+    for (uint16_t codes = gives; codes != 0; codes &= codes - 1){
+        const CompoundMove give = { NO_FIELD, lowestBitIndex(codes) };
+        int opponentValue = 1;          //The opponent wins immediately with a winning meeple
+        if ((winningCodes & (1 << give.give)) == 0){
+            CompoundMove opponentMove;
+            if (!probe(playMove(position, give), opponentMove, &opponentValue)){
+                return false;
+            }
+        }
+        const int ownValue = (opponentValue > 0) ? -(opponentValue + 1) : (opponentValue < 0 ? -opponentValue + 1 : 0);
+        if (move.give == NO_MEEPLE || getValueScore(ownValue) > getValueScore(bestValue)){
+            bestValue = ownValue;
+            move.give = give.give;
+        }
+    }
+    assert(move.give != NO_MEEPLE);
+    if (value != nullptr){
+        *value = bestValue;
+    }
+    return true;
+}
+
+
+
+//Solves the position (and its symmetric positions), if it isn't in the table yet
+static void addPosition(const Position& position, SolverAI& solver, std::unordered_map<uint64_t, TablebaseEntry>& solved){
+    Position canonical;
+    canonicalize(position, canonical);
+    if (solved.find(canonical.cells) != solved.end()){
+        return;
+    }
+    CompoundMove move = solver.searchBestMove(canonical);
+    TablebaseEntry entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.key = canonical.cells;
+    entry.value = getSolverValue(solver.getScore());
+    entry.field = move.field;
+    entry.give = move.give;
+    solved[entry.key] = entry;
+}
+
+bool generateTablebase(unsigned int maxEmptyFields, unsigned int games, const std::string& path){
+    assert(maxEmptyFields >= 1 && maxEmptyFields <= TABLEBASE_MAX_EMPTY_FIELDS);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::unordered_map<uint64_t, TablebaseEntry> solved;
+    SolverAI solver(SearchLimits(FIELD_COUNT + 1), 1, 64);     //Searches until the end of the game --> exact results
+    srand(1);                                                   //The same games in every run
+
+    std::cout << "Solving the positions of " << games << " games with up to " << maxEmptyFields << " empty fields..." << std::endl;
+    for (unsigned int g = 0; g < games; ++g){
+        //Random game (without giving away immediate wins):
+        Position position = Position::empty();
+        for (;;){
+            const bool meepleWins = position.meepleToSet != NO_MEEPLE && (getWinningCodes(position) & (1 << position.meepleToSet)) != 0;
+            if (meepleWins){
+                break;      //Positions with an immediate win are trivial - they aren't stored
+            }
+            MoveList moves;
+            generateMoves(position, moves, MoveFilter::NO_LOSING_GIVES);
+            if (position.meepleToSet != NO_MEEPLE && static_cast<unsigned int>(FIELD_COUNT - popcount16(position.occupied)) <= maxEmptyFields){
+                addPosition(position, solver, solved);
+                for (unsigned int m = 0; m < moves.count; ++m){     //All positions, which the opponent can get (the meepleToSet of the opponent can't win)
+                    if (moves.moves[m].give != NO_MEEPLE){
+                        addPosition(playMove(position, moves.moves[m]), solver, solved);
+                    }
+                }
+            }
+            const CompoundMove& move = moves.moves[rand() % moves.count];
+            if (move.give == NO_MEEPLE){
+                break;
+            }
+            position = playMove(position, move);
+        }
+        if ((g + 1) % 100 == 0 || g + 1 == games){
+            std::cout << "  " << g + 1 << " games, " << solved.size() << " positions" << std::endl;
+        }
+    }
+
+    //Hash table with a load factor <= 50%:
+    uint64_t capacity = 1;
+    while (capacity < 2 * solved.size()){
+        capacity *= 2;
+    }
+    std::vector<TablebaseEntry> table(static_cast<size_t>(capacity));
+    memset(&table[0], 0, table.size() * sizeof(TablebaseEntry));
+    for (std::unordered_map<uint64_t, TablebaseEntry>::const_iterator it = solved.begin(); it != solved.end(); ++it){
+        uint64_t slot = getSlot(it->first, capacity);
+        while (table[static_cast<size_t>(slot)].key != 0){
+            slot = (slot + 1) & (capacity - 1);
+        }
+        table[static_cast<size_t>(slot)] = it->second;
+    }
+
+    TablebaseHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "4WTB", 4);
+    header.version = TABLEBASE_VERSION;
+    header.maxEmptyFields = maxEmptyFields;
+    header.capacity = capacity;
+    header.entryCount = solved.size();
+
+    std::ofstream output(path.c_str(), std::ios::binary | std::ios::trunc);
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(reinterpret_cast<const char*>(&table[0]), table.size() * sizeof(TablebaseEntry));
+    if (!output){
+        std::cout << "Couldn't write " << path << std::endl;
+        return false;
+    }
+    std::cout << "Wrote " << solved.size() << " positions (" << (sizeof(header) + table.size() * sizeof(TablebaseEntry)) / 1024 << " KB) to " << path << " in " << std::fixed << std::setprecision(1)
+        << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << " s" << std::endl;
+    return true;
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+#include "Position.h"
+#include "MoveGenerator.h"
+#include "MappedFile.h"
+#include "config.h"
+
+
+//Endgame tablebase: exact results (win/loss/tie + distance) and best moves of positions with few empty fields
+//The positions are stored in their canonical form (see canonicalize()): all symmetric positions share one entry
+//The file is an open-addressing hash table (keyed by the canonical board), which is memory-mapped at startup --> a probe is one lookup in the mapping
+//
+//Every position with K empty fields can't be stored (there are ~10^12 positions with 8 empty fields, ~10^9 without symmetries)
+//--> the generator solves the positions of many sampled games: each position on the path of a game, and each position, which the opponent can get from it
+//A position, which isn't in the table, is searched by the AI as usual
+
+
+#define TABLEBASE_FILE WORKING_DIR "endgame.tb"     //Loaded at startup, if it exists
+#define TABLEBASE_MAX_EMPTY_FIELDS 10               //The SolverAI can solve positions with up to 10 empty fields in a fraction of a second
+#define TABLEBASE_DEFAULT_GAMES 2000                //Number of sampled games for the generator
+#define TABLEBASE_VERSION 1
+
+
+//Result of a position for the side to move: > 0: win, < 0: loss, 0: tie; |value| - 1 = turns until the end of the game (0: the move ends the game)
+struct TablebaseEntry{
+    uint64_t key;               //cells of the canonical position (0: empty slot; the canonical meepleToSet has the code 0 --> it's never on the board, and 0 means an empty field)
+    int8_t value;
+    uint8_t field;              //Best move in the canonical position
+    uint8_t give;
+    uint8_t reserved[5];
+};
+
+struct TablebaseHeader{
+    char magic[4];              //"4WTB"
+    uint32_t version;
+    uint32_t maxEmptyFields;    //The table contains positions with up to this number of empty fields
+    uint32_t reserved;
+    uint64_t capacity;          //Number of slots (a power of 2)
+    uint64_t entryCount;        //Number of used slots
+};
+
+
+class Tablebase{
+private:
+    MappedFile file;
+    const TablebaseHeader* header;
+    const TablebaseEntry* entries;
+
+    Tablebase(const Tablebase&);
+    Tablebase& operator = (const Tablebase&);
+public:
+    Tablebase();
+
+    static Tablebase& getGlobal();                      //The table, which is used by the AIs (see TABLEBASE_FILE)
+
+    bool load(const std::string& path);                 //Maps the file; returns false, if it doesn't exist or is invalid
+    void unload();
+    bool isLoaded() const;
+    unsigned int getMaxEmptyFields() const;             //0, if no table is loaded
+    uint64_t getEntryCount() const;
+
+    const TablebaseEntry* find(uint64_t key) const;     //Looks up the canonical key; nullptr, if it isn't in the table
+
+    //Looks up the best move of the position (with or without a meepleToSet); returns false, if the result isn't known
+    //value (optional): result of the position for the side to move (see TablebaseEntry::value)
+    bool probe(const Position& position, CompoundMove& move, int* value = nullptr) const;
+};
+
+
+//Solves the positions of the sampled games (up to maxEmptyFields empty fields), and writes the table to the file; prints the progress to the console
+bool generateTablebase(unsigned int maxEmptyFields, unsigned int games, const std::string& path);
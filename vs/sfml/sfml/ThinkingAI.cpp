@@ -1,28 +1,23 @@
 #include "ThinkingAI.h"
 
 #include <iostream>
+#include <climits>
 #include <assert.h>
 
 #include "Board.h"
 #include "MeepleBag.h"
 #include "config.h"
 #include "GameState.h"
-#include "helper.h"
+#include "Zobrist.h"
 
 #pragma warning( disable: 4100 )
 
 
 
-ThinkingAI::ThinkingAI(bool intelligentMeepleChoosing, bool intelligentMeeplePositioning) : 
-    intelligentMeepleChoosing(intelligentMeepleChoosing), intelligentMeeplePositioning(intelligentMeeplePositioning){
+ThinkingAI::ThinkingAI(bool intelligentMeepleChoosing, bool intelligentMeeplePositioning, const HeuristicParameters& parameters) : 
+    intelligentMeepleChoosing(intelligentMeepleChoosing), intelligentMeeplePositioning(intelligentMeeplePositioning), parameters(parameters){
 }
 
-struct MeeplePoints{ //Internal structure, which is needed during the computation of the meeple to be chosen
-    const Meeple* meeple;
-    int points;
-};
-
-
 const Meeple& ThinkingAI::selectOpponentsMeeple(const GameState& gameState) {
     if (!intelligentMeepleChoosing){
         return *gameState.opponentBag->getMeeple(0);
@@ -32,53 +27,49 @@ const Meeple& ThinkingAI::selectOpponentsMeeple(const GameState& gameState) {
     We calculate the scoreMap, which the opponent would get, if we would choose the meeple.
     --> calculate the best score, and the average score for the map
     --> calculate the points out of these 2 values --> these are the points for the meeple
-    --> store the meeple and its points in a MeeplePoints-set
     Afterwards, select the meeple with the lowest points
     */
   
-    unsigned int meepleCount = gameState.opponentBag->getMeepleCount();
-
-    MeeplePoints* points = new MeeplePoints[meepleCount];                       //Each meeple in the opponents bag will get an entry .. soon
-    
+    const unsigned int meepleCount = gameState.opponentBag->getMeepleCount();
+    assert(meepleCount > 0 && meepleCount <= THINKING_AI_MAX_MEEPLES);
+    const Meeple* meeples[THINKING_AI_MAX_MEEPLES];
+    for (unsigned int i = 0; i < meepleCount; ++i){
+        meeples[i] = gameState.opponentBag->getMeeple(i);
+    }
+    int scoreMaps[THINKING_AI_MAX_MEEPLES][FIELD_COUNT];
+    buildScoreMaps(gameState, meeples, meepleCount, scoreMaps);         //The opponent gets scoreMaps[i], if meeples[i] is chosen
 
     #if PRINT_THINK_MAP
         std::cout << "Thinkingmap for selecting a meeple:" << std::endl;
     #endif
 
-    int* scoreMap;
-    int f = 0;
-    for (; f < static_cast<int>(meepleCount); ++f){
-        points[f].meeple = gameState.opponentBag->getMeeple(f);
-        
-        scoreMap = buildScoreMap(gameState, *points[f].meeple);          //The opponent gets this map, if this meeple is chosen
-        
-        int best = getMaximum(scoreMap, 4 * 4);
-        float avg = getAverage(scoreMap, 4 * 4);
-        
-        delete[] scoreMap;
+    int lowestPoints = 0;
+    int lowest = -1;
+    for (int i = static_cast<int>(meepleCount) - 1; i >= 0; --i){      //From the last meeple on: with the same points, the last one is chosen
+        //Max. and average of the map in one pass:
+        int best = scoreMaps[i][0];
+        long sum = 0;
+        for (unsigned int f = 0; f < FIELD_COUNT; ++f){
+            best = (scoreMaps[i][f] > best) ? scoreMaps[i][f] : best;
+            sum += scoreMaps[i][f];
+        }
+        const float avg = sum / static_cast<float>(FIELD_COUNT);
 
-        points[f].points = best * 8 + (int)(avg * 2.f);  //The higher this score, the better for the opponent
+        const int points = best * parameters.get(HeuristicParameter::SELECT_MAX_WEIGHT) + (int)(avg * static_cast<float>(parameters.get(HeuristicParameter::SELECT_AVERAGE_WEIGHT)));  //The higher this score, the better for the opponent
+        if (lowest < 0 || points < lowestPoints){
+            lowestPoints = points;
+            lowest = i;
+        }
 
         #if PRINT_THINK_MAP
-            std::cout << points[f].meeple->toString() << ":  Score = " << points[f].points << " (max: " << best << ", avg: " << avg << ")" << std::endl;
+            std::cout << meeples[i]->toString() << ":  Score = " << points << " (max: " << best << ", avg: " << avg << ")" << std::endl;
         #endif
     }
 
-    //Select the lowest score:
-    MeeplePoints* lowest = &points[--f];
-    while (--f >= 0){
-        if (points[f].points < lowest->points){
-            lowest = &points[f];
-        }
-    }
-
-    const Meeple* selection = lowest->meeple;
-    delete[] points;
-
     #if PRINT_THINK_MAP
-        std::cout << "Choosing meeple " << selection->toString() << std::endl << std::endl;
+        std::cout << "Choosing meeple " << meeples[lowest]->toString() << std::endl << std::endl;
     #endif
-    return *selection;
+    return *meeples[lowest];
 }
 
 BoardPos ThinkingAI::selectMeeplePosition(const GameState& gameState, const Meeple& meepleToSet){
@@ -86,11 +77,10 @@ BoardPos ThinkingAI::selectMeeplePosition(const GameState& gameState, const Meep
         return gameState.board->getRandomEmptyField();
     }
 
-    int* scoreMap = buildScoreMap(gameState, meepleToSet);
-    BoardPos pos = getOptimalScoreMapPosition(scoreMap, PRINT_THINK_MAP);
-
-    delete[] scoreMap;
-    return pos;
+    const Meeple* meeple = &meepleToSet;
+    int scoreMap[1][FIELD_COUNT];
+    buildScoreMaps(gameState, &meeple, 1, scoreMap);
+    return getOptimalScoreMapPosition(scoreMap[0], PRINT_THINK_MAP);
 }
 
 
@@ -98,8 +88,41 @@ BoardPos ThinkingAI::selectMeeplePosition(const GameState& gameState, const Meep
 
 
 
-int* ThinkingAI::buildScoreMap(const GameState& gameState, const Meeple& meepleToSet) const{
-    int* scoreMap = new int[4 * 4]{0};
+void ThinkingAI::buildScoreMaps(const GameState& gameState, const Meeple* const* meeples, unsigned int meepleCount, int scoreMaps[][FIELD_COUNT]){
+    assert(meepleCount <= THINKING_AI_MAX_MEEPLES);
+    uint64_t keys[THINKING_AI_MAX_MEEPLES];
+    const Meeple* missing[THINKING_AI_MAX_MEEPLES];     //The meeples, whose maps aren't in the cache
+    unsigned int missingIndex[THINKING_AI_MAX_MEEPLES];
+    unsigned int missingCount = 0;
+    for (unsigned int i = 0; i < meepleCount; ++i){
+        keys[i] = getScoreMapKey(gameState, *meeples[i]);
+        if (!scoreMapCache.probe(keys[i], scoreMaps[i])){
+            missing[missingCount] = meeples[i];
+            missingIndex[missingCount++] = i;
+        }
+    }
+    if (missingCount == 0){
+        return;
+    }
+
+    int calculated[THINKING_AI_MAX_MEEPLES][FIELD_COUNT];
+    calculateScoreMaps(gameState, missing, missingCount, calculated);
+    for (unsigned int m = 0; m < missingCount; ++m){
+        const unsigned int i = missingIndex[m];
+        for (unsigned int f = 0; f < FIELD_COUNT; ++f){
+            scoreMaps[i][f] = calculated[m][f];
+        }
+        scoreMapCache.store(keys[i], calculated[m]);
+    }
+}
+
+void ThinkingAI::calculateScoreMaps(const GameState& gameState, const Meeple* const* meeples, unsigned int meepleCount, int scoreMaps[][FIELD_COUNT]) const{
+    assert(meepleCount <= THINKING_AI_MAX_MEEPLES);
+    for (unsigned int i = 0; i < meepleCount; ++i){
+        for (unsigned int f = 0; f < FIELD_COUNT; ++f){
+            scoreMaps[i][f] = 0;
+        }
+    }
 
     //go through the whole map, and add points if the meeple should be set there
     //  --> check all possible combinations, which can lead to a victory (4 in a row/col/diagonal)
@@ -109,27 +132,31 @@ int* ThinkingAI::buildScoreMap(const GameState& gameState, const Meeple& meepleT
     //(Afterwards, go through the scoreMap, and choose the field with the most points)
 
     const WinCombinationSet* allCombinations = gameState.board->getWinCombinations();
-    for (std::set<WinCombination*>::const_iterator it = allCombinations->combination.begin(); it != allCombinations->combination.end(); ++it){
-        WinCombination* comb = *it;
-        int points = getPointsForCombination(gameState, *comb, meepleToSet);
+    for (uint8_t line = 0; line < WIN_LINE_COUNT; ++line){
+        const WinCombination* comb = &allCombinations->combination[line];
+        int points[THINKING_AI_MAX_MEEPLES];
+        getPointsForAllMeeples(gameState, *comb, meeples, meepleCount, points);
         for (int m = 0; m < 4; ++m){
             uint8_t field = comb->positions[m].x + 4 * comb->positions[m].y;        //convert 2D-coords [x][y] to [0-15] value (0 = top left, 3 = top right)
             if (comb->meeples[m] == nullptr){       //The field is empty, the meeple can be set here --> add the points
-                scoreMap[field] += points + 1;      //+1 --> diagonal fields have automatically 1 point more than others (the more combinations a field is part of, the more points it gets ---> AIs prefer diagonals)
-                assert(scoreMap[field] > -10000);   //everything else would make no sense
+                for (unsigned int i = 0; i < meepleCount; ++i){
+                    scoreMaps[i][field] += points[i] + 1;       //+1 --> diagonal fields have automatically 1 point more than others (the more combinations a field is part of, the more points it gets ---> AIs prefer diagonals)
+                    assert(scoreMaps[i][field] > -10000);       //everything else would make no sense
+                }
             }else{
-                scoreMap[field] = INT_MIN;
+                for (unsigned int i = 0; i < meepleCount; ++i){
+                    scoreMaps[i][field] = INT_MIN;
+                }
             }
         }
     }
-    return scoreMap;
 }
 
 
 
 //Finds the highest value in the scoreMap, and returns the position of the field. Optionally prints the scoreMap
 //If there are several fields with the same score, this function chooses a field randomly
-BoardPos ThinkingAI::getOptimalScoreMapPosition(int* scoreMap, bool printScoreMap){
+BoardPos ThinkingAI::getOptimalScoreMapPosition(const int* scoreMap, bool printScoreMap){
     int points = scoreMap[0];
     uint8_t pos = 0;
     unsigned int randMod = 2;   //needed for random choosing between fields with the same score (to provide the same propability for all fields)
@@ -172,43 +199,78 @@ BoardPos ThinkingAI::getOptimalScoreMapPosition(int* scoreMap, bool printScoreMa
 
 
 
-int ThinkingAI::getPointsForCombination(const GameState& gameState, const WinCombination& winCombination, const Meeple& meepleToSet) const{
-    //returns points for all un-occupied fields in the winCombination (more points, if the AI should place it's meeple there)
-    // --> take each property of the selectedMeeple
-    // --> go through all meeples in the combination-set. If a meeple has the same property, add some points.
-    // --> if the meeple has a different property, remove some points (we would block the field for further usage)
+uint64_t ThinkingAI::getScoreMapKey(const GameState& gameState, const Meeple& meepleToSet) const{
+    return gameState.board->getHash() ^ ZOBRIST.meepleToSet[meepleToSet.getCode()];
+}
 
-    //return the points. The caller than has to assign this points to all positions, where no meeple is currently present
-    
-    int m, p;
-    int propPoints[4] = { 0 };  //Each property (color, shape, size, detail) gets its own similarity-points
+void ThinkingAI::printStatistics(std::ostream& output) const{
+    scoreMapCache.printStatistics(output);
+}
 
-    for (m = 0; m < 4; ++m){
+
+
+//Index of the lowest set bit of a 4 bit mask (4, if no bit is set)
+static const uint8_t LOWEST_PROPERTY[16] = { 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0 };
+
+//The points of getPointsForCombination() for several meeples, computed from the meeple codes (bit p of a code = value of the property p)
+//Each meeple is an independent lane without branches: the compiler can vectorize the loops over the meeples
+static void getCombinationPoints(const WinCombination& winCombination, const uint8_t* codes, unsigned int count, int* points, const HeuristicParameters& parameters){
+    const int matchPoints = parameters.get(HeuristicParameter::PROPERTY_MATCH_POINTS);
+    const int blockedPoints = parameters.get(HeuristicParameter::PROPERTY_BLOCKED_POINTS);
+    assert(matchPoints > 0 && blockedPoints < 0);      //A property is dead, if its points are negative
+    int propPoints[4][THINKING_AI_MAX_MEEPLES];     //[property][meeple]
+    for (unsigned int p = 0; p < 4; ++p){
+        for (unsigned int i = 0; i < count; ++i){
+            propPoints[p][i] = 0;
+        }
+    }
+
+    for (unsigned int m = 0; m < 4; ++m){
         if (winCombination.meeples[m] == nullptr){
             continue;
         }
-        for (p = 0; p < 4; ++p){    //For each property
-            if (propPoints[p] < 0){ //we already know that his property can never lead to a win
-                break;
-            }
-            if (winCombination.meeples[m]->getProperty(p) == meepleToSet.getProperty(p)){
-                propPoints[p] += 5;
-            }else{  //property will never match -> negative points (we would destroy the opportunity to use this field later for another combination)
-                propPoints[p] = -2;
-                break;
+        const uint8_t lineCode = winCombination.meeples[m]->getCode();
+        for (unsigned int i = 0; i < count; ++i){
+            //The properties are checked in their order, until the first one, which can't lead to a win anymore, or which doesn't match:
+            const unsigned int dead = (propPoints[0][i] < 0) | (propPoints[1][i] < 0) << 1 | (propPoints[2][i] < 0) << 2 | (propPoints[3][i] < 0) << 3;
+            const unsigned int stop = LOWEST_PROPERTY[((lineCode ^ codes[i]) & 0xF) | dead];
+            for (unsigned int p = 0; p < 4; ++p){
+                propPoints[p][i] = (p < stop) ? propPoints[p][i] + matchPoints : (p == stop ? blockedPoints : propPoints[p][i]);     //blockedPoints for a dead property don't change it
             }
         }
     }
 
-   
-    int bonus = 0;
-    int sum = 0;
-    for (p = 0; p < 4; p++){
-        sum += propPoints[p];
-        if (propPoints[p] >= 15){      //It's possible to win the game with this move
-            bonus = 20;
+    for (unsigned int i = 0; i < count; ++i){
+        int bonus = 0;
+        int sum = 0;
+        for (unsigned int p = 0; p < 4; ++p){
+            sum += propPoints[p][i];
+            if (propPoints[p][i] >= 3 * matchPoints){      //It's possible to win the game with this move
+                bonus = parameters.get(HeuristicParameter::WIN_BONUS);
+            }
         }
+        points[i] = bonus + sum;
     }
+}
+
+
+int ThinkingAI::getPointsForCombination(const GameState& gameState, const WinCombination& winCombination, const Meeple& meepleToSet) const{
+    //returns points for all un-occupied fields in the winCombination (more points, if the AI should place it's meeple there)
+    // --> take each property of the selectedMeeple
+    // --> go through all meeples in the combination-set. If a meeple has the same property, add some points.
+    // --> if the meeple has a different property, remove some points (we would block the field for further usage)
 
-    return bonus +sum;
+    //return the points. The caller than has to assign this points to all positions, where no meeple is currently present
+    const uint8_t code = meepleToSet.getCode();
+    int points;
+    getCombinationPoints(winCombination, &code, 1, &points, parameters);
+    return points;
+}
+
+void ThinkingAI::getPointsForAllMeeples(const GameState& gameState, const WinCombination& winCombination, const Meeple* const* meeples, unsigned int meepleCount, int* points) const{
+    uint8_t codes[THINKING_AI_MAX_MEEPLES];
+    for (unsigned int i = 0; i < meepleCount; ++i){
+        codes[i] = meeples[i]->getCode();
+    }
+    getCombinationPoints(winCombination, codes, meepleCount, points, parameters);
 }
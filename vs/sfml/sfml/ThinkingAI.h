@@ -1,22 +1,40 @@
 #pragma once
 #include "I_AI.h"
+#include "Bitboard.h"
+#include "ScoreMapCache.h"
+#include "HeuristicParameters.h"
 struct WinCombination;
 
+#define THINKING_AI_MAX_MEEPLES 8       //Max. number of meeples, which are rated at once (a bag contains 8 meeples)
+
 class ThinkingAI : public I_AI{
-private:
+protected:
     const bool intelligentMeepleChoosing;
     const bool intelligentMeeplePositioning;
+    const HeuristicParameters parameters;       //The weights of the heuristic
+private:
+    ScoreMapCache scoreMapCache;
 
-    int* buildScoreMap(const GameState& gameState, const Meeple& meepleToSet) const;        //Caclulated the points for each combination, and sums the points up for each field on the board; the field with the highest points should get chosen for meeple positioning; Note: the return-value has to be deleted[]
-    BoardPos getOptimalScoreMapPosition(int* scoreMap, bool printScoreMap);                 //Searches for the field with the best score in the scoreMap, and returns its position
+    //Returns the score map of each meeple (scoreMaps[meeple][field]): from the cache, or calculated with calculateScoreMaps()
+    void buildScoreMaps(const GameState& gameState, const Meeple* const* meeples, unsigned int meepleCount, int scoreMaps[][FIELD_COUNT]);
+    //Calculates the points of each combination for each meeple, and sums the points up for each field on the board; the field with the highest points should get chosen for meeple positioning
+    //All meeples are rated in one pass over the combinations; occupied fields get INT_MIN
+    void calculateScoreMaps(const GameState& gameState, const Meeple* const* meeples, unsigned int meepleCount, int scoreMaps[][FIELD_COUNT]) const;
+    BoardPos getOptimalScoreMapPosition(const int* scoreMap, bool printScoreMap);           //Searches for the field with the best score in the scoreMap, and returns its position
  
     ThinkingAI& operator = (const ThinkingAI&);
 protected:
     virtual int getPointsForCombination(const GameState& gameState, const WinCombination& winCombination, const Meeple& meepleToSet) const;
+    //points[i] = getPointsForCombination() of meeples[i]; the ThinkingAI rates all meeples at once by their codes
+    virtual void getPointsForAllMeeples(const GameState& gameState, const WinCombination& winCombination, const Meeple* const* meeples, unsigned int meepleCount, int* points) const;
+    //Key of the score map in the cache: everything, on which getPointsForCombination() depends (the ThinkingAI only looks at the board)
+    virtual uint64_t getScoreMapKey(const GameState& gameState, const Meeple& meepleToSet) const;
 
 public:
-    ThinkingAI(bool intelligentMeepleChoosing = true, bool intelligentMeeplePositioning = true);
+    ThinkingAI(bool intelligentMeepleChoosing = true, bool intelligentMeeplePositioning = true, const HeuristicParameters& parameters = HeuristicParameters::getGlobal());
 
     virtual const Meeple& selectOpponentsMeeple(const GameState& gameState);
     virtual BoardPos selectMeeplePosition(const GameState& gameState, const Meeple& meepleToSet);
+
+    virtual void printStatistics(std::ostream& output) const;
 };
@@ -10,9 +10,11 @@
 
 ThreadController::ThreadController(I_Player& player) : playerThread(nullptr),
                                                        threadAlive(false), 
+                                                       pondering(false),
                                                        lock(mutex, std::defer_lock),        //defer_lock = don't lock the mutex
                                                        command({ ThreadCommand::TERMINATE, nullptr, nullptr }),
                                                        commandAvailable(false),
+                                                       ponderStop(false),
                                                        opponentsMeeple(nullptr), 
                                                        meeplePosition({ -1, -1 }),
                                                        resultAvailable(false),
@@ -33,6 +35,7 @@ void ThreadController::initialiseThread(){
 
 ThreadController::~ThreadController(){
     if (threadAlive){
+        stopPondering();
         lock.lock();       
             #if THREAD_DEBUGGING
                 std::cout << "Sending terminate-command to thread" << std::endl;
@@ -98,6 +101,11 @@ void ThreadController::threadMainRoutine(ThreadController* controller){
                 meeplePosition = { 42, 42 };
                 controller->player->reset();
                 break;
+            case ThreadCommand::PONDER:
+                opponentsMeeple = nullptr;
+                meeplePosition = { 42, 42 };
+                controller->player->ponder(command.position, controller->ponderStop);
+                break;
             case ThreadCommand::TERMINATE: 
                 return;
         }
@@ -127,6 +135,7 @@ bool ThreadController::isResultAvailable(){
 }
 
 void ThreadController::run_selectOpponentsMeeple(const GameState& gameState){
+    stopPondering();                            //The real task replaces the pondering
     initialiseThread();                         //Initialise the thread, if it doesn't exist yet  
     lock.lock();    
         assert(!commandAvailable);              //we can't send a new command, if there is still a command in the queue
@@ -143,6 +152,7 @@ void ThreadController::run_selectOpponentsMeeple(const GameState& gameState){
 }
 
 void ThreadController::run_selectMeeplePosition(const GameState& gameState, const Meeple& meepleToSet){
+    stopPondering();                            //The real task replaces the pondering
     initialiseThread();                         //Initialise the thread, if it doesn't exist yet  
     lock.lock();    
         assert(!commandAvailable);              //we can't send a new command, if there is still a command in the queue
@@ -159,6 +169,7 @@ void ThreadController::run_selectMeeplePosition(const GameState& gameState, cons
 }   
 
 void ThreadController::run_resetPlayer(){
+    stopPondering();                            //The real task replaces the pondering
     initialiseThread();                         //Initialise the thread, if it doesn't exist yet  
     lock.lock();    
         assert(!commandAvailable);              //we can't send a new command, if there is still a command in the queue
@@ -174,6 +185,34 @@ void ThreadController::run_resetPlayer(){
     cv.notify_one();  
 }
 
+void ThreadController::run_ponder(const GameState& gameState, const Meeple* meepleToSet){
+    stopPondering();                            //The position has changed: start again
+    initialiseThread();                         //Initialise the thread, if it doesn't exist yet  
+    lock.lock();    
+        assert(!commandAvailable);              //we can't send a new command, if there is still a command in the queue
+        assert(!resultAvailable);               //we can't send a new command, if the result from the old one hasn't been read yet.
+        
+        command = { ThreadCommand::PONDER, nullptr, nullptr, Position::fromGameState(gameState, meepleToSet) };
+        
+        #if THREAD_DEBUGGING
+            std::cout << "Sending new command to thread: " << command.toString() << std::endl;
+        #endif
+        ponderStop.store(false);
+        pondering = true;
+        commandAvailable = true;
+    lock.unlock();
+    cv.notify_one();  
+}
+
+void ThreadController::stopPondering(){
+    if (!pondering){
+        return;
+    }
+    ponderStop.store(true);                     //The player checks the flag regularly
+    confirmTaskCompletion();                    //The pondering has no result
+    pondering = false;
+}
+
 const Meeple& ThreadController::getOpponentsMeeple(){
     lock.lock();
         assert(commandAvailable || resultAvailable);    //calling this function makes no sense if the thread never received a task
@@ -4,7 +4,9 @@
 #include <thread>
 #include <mutex>
 #include <condition_variable>
+#include <atomic>
 #include "Board.h"
+#include "Position.h"
 #include "I_Player.h"
 
 class GameState;
@@ -15,11 +17,13 @@ struct ThreadCommand{                       //A command that is transmitted from
         SELECT_OPPONENTS_MEEPLE,
         SELECT_MEEPLE_POSITION,
         RESET_PLAYER,
+        PONDER,
         TERMINATE
     } type;
 
     const GameState* gameState;
     const Meeple* meepleToSet;          //Only needed for the type "SELECT_MEEPLE_POSITION"
+    Position position;                  //Only needed for the type "PONDER": a copy, since the board is modified during the opponent's turn
 
     std::string toString();
 };
@@ -32,6 +36,7 @@ private:
 //Main thread only:
     std::thread* playerThread; 
     bool threadAlive;                       //true, as long as the thread is alive (thread can be started by calling initialiseThread)
+    bool pondering;                         //true, while the thread works on a PONDER command (it has no result, which the caller would read)
     void initialiseThread();                //Starts the thread - lazy call (the thread is generated as soon as the caller requires it)   
 
 //Thread Interface:
@@ -41,6 +46,7 @@ private:
     //send task-to-thread:
         ThreadCommand command;              //Contains the command, which should be performed by the thread
         bool commandAvailable;              //true: there's a new command for the player-thread, which hasn't completed yet (also true while the thread is working on it)
+        std::atomic<bool> ponderStop;       //Set by the main thread to end a PONDER command
     //get result-from-thread:
         const Meeple* opponentsMeeple;          
         BoardPos meeplePosition;                
@@ -63,6 +69,9 @@ public:
 	//tells where to place the meeple chosen by the opponent
     void run_selectMeeplePosition(const GameState& gameState, const Meeple& meepleToSet);
     void run_resetPlayer();
+    //the player thinks about its next move during the opponent's turn (gameState = the opponent's state); ends with the next command, or stopPondering()
+    void run_ponder(const GameState& gameState, const Meeple* meepleToSet);
+    void stopPondering();                   //Stops the pondering and waits for the thread (nothing happens, if the thread isn't pondering)
 //Get the results of the thread-tasks:
     const Meeple& getOpponentsMeeple();
     BoardPos getMeeplePosition();
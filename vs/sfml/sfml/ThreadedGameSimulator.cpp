@@ -14,7 +14,7 @@
 
 
 std::string ThreadCommand::toString(){
-    return type == TERMINATE ? "terminate" : type == SELECT_OPPONENTS_MEEPLE ? "select opponent's meeple" : type == SELECT_MEEPLE_POSITION ? "select meeple position" : "reset player";
+    return type == TERMINATE ? "terminate" : type == SELECT_OPPONENTS_MEEPLE ? "select opponent's meeple" : type == SELECT_MEEPLE_POSITION ? "select meeple position" : type == PONDER ? "ponder" : "reset player";
 }
 
 
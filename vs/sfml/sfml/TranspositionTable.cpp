@@ -0,0 +1,187 @@
+#include "TranspositionTable.h"
+
+#include <iomanip>
+#include <new>
+#include <assert.h>
+
+
+
+//Layout of the data word: bits 0-15 = score, 16-23 = depth, 24-31 = bound, 32-39 = field, 40-47 = give, 48-55 = generation
+static uint64_t packEntry(const TTEntry& entry, uint8_t generation){
+    return static_cast<uint64_t>(static_cast<uint16_t>(entry.score))
+        | (static_cast<uint64_t>(entry.depth) << 16)
+        | (static_cast<uint64_t>(entry.bound) << 24)
+        | (static_cast<uint64_t>(entry.field) << 32)
+        | (static_cast<uint64_t>(entry.give) << 40)
+        | (static_cast<uint64_t>(generation) << 48);
+}
+
+static TTEntry unpackEntry(uint64_t data){
+    TTEntry entry;
+    entry.score = static_cast<int16_t>(data & 0xFFFF);
+    entry.depth = static_cast<uint8_t>(data >> 16);
+    entry.bound = static_cast<uint8_t>(data >> 24);
+    entry.field = static_cast<uint8_t>(data >> 32);
+    entry.give = static_cast<uint8_t>(data >> 40);
+    return entry;
+}
+
+static uint8_t getGeneration(uint64_t data){
+    return static_cast<uint8_t>(data >> 48);
+}
+
+
+#if TT_STATISTICS
+    #define TT_COUNT(counter) counter.fetch_add(1, std::memory_order_relaxed)
+#else
+    #define TT_COUNT(counter)
+#endif
+
+
+
+TranspositionTable::TranspositionTable(size_t megaBytes) : generation(0){
+    static_assert(sizeof(Slot) == 16 && sizeof(Bucket) == TT_CACHE_LINE_SIZE, "a bucket has to fill exactly one cache line");
+
+    size_t bucketCount = 1;
+    while (bucketCount * 2 * sizeof(Bucket) <= megaBytes * 1024 * 1024){
+        bucketCount *= 2;
+    }
+    bucketMask = bucketCount - 1;
+
+    //new[] doesn't guarantee the alignment to cache lines --> allocate 1 cache line more, and start at the first aligned address
+    memory = new unsigned char[bucketCount * sizeof(Bucket) + TT_CACHE_LINE_SIZE];
+    size_t misalignment = reinterpret_cast<uintptr_t>(memory) % TT_CACHE_LINE_SIZE;
+    buckets = reinterpret_cast<Bucket*>(memory + (misalignment == 0 ? 0 : TT_CACHE_LINE_SIZE - misalignment));
+    for (size_t b = 0; b < bucketCount; ++b){
+        new (&buckets[b]) Bucket();         //The atomics have to be constructed in the raw memory
+    }
+
+    clear();
+}
+
+TranspositionTable::~TranspositionTable(){
+    for (uint64_t b = 0; b <= bucketMask; ++b){
+        buckets[b].~Bucket();
+    }
+    delete[] memory;
+}
+
+
+void TranspositionTable::clear(){
+    for (uint64_t b = 0; b <= bucketMask; ++b){
+        for (unsigned int s = 0; s < TT_BUCKET_SIZE; ++s){
+            buckets[b].slots[s].keyXorData.store(0, std::memory_order_relaxed);     //An entry of 0/0 has the bound NONE --> empty
+            buckets[b].slots[s].data.store(0, std::memory_order_relaxed);
+        }
+    }
+    generation.store(0, std::memory_order_relaxed);
+    resetStatistics();
+}
+
+void TranspositionTable::newSearch(){
+    generation.store(static_cast<uint8_t>(generation.load(std::memory_order_relaxed) + 1), std::memory_order_relaxed);
+}
+
+
+bool TranspositionTable::probe(uint64_t hash, TTEntry& entry){
+    TT_COUNT(probeCount);
+    Bucket& bucket = buckets[hash & bucketMask];
+    bool full = true;
+    for (unsigned int s = 0; s < TT_BUCKET_SIZE; ++s){
+        uint64_t data = bucket.slots[s].data.load(std::memory_order_relaxed);
+        uint64_t key = bucket.slots[s].keyXorData.load(std::memory_order_relaxed) ^ data;
+        if (key == hash && data != 0){
+            entry = unpackEntry(data);
+            TT_COUNT(hitCount);
+            return true;
+        }
+        full = full && (data != 0);
+    }
+    if (full){
+        TT_COUNT(collisionCount);
+    }
+    return false;
+}
+
+void TranspositionTable::store(uint64_t hash, const TTEntry& entry){
+    assert(entry.bound != TTBound::NONE);
+    TT_COUNT(storeCount);
+    Bucket& bucket = buckets[hash & bucketMask];
+    const uint8_t currentGeneration = generation.load(std::memory_order_relaxed);
+
+    //Take the slot of the position, or replace the least valuable entry (empty < older searches < lower depth):
+    Slot* target = nullptr;
+    int targetValue = INT32_MAX;
+    bool samePosition = false;
+    for (unsigned int s = 0; s < TT_BUCKET_SIZE; ++s){
+        Slot& slot = bucket.slots[s];
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        if ((slot.keyXorData.load(std::memory_order_relaxed) ^ data) == hash && data != 0){
+            TTEntry old = unpackEntry(data);
+            if (entry.depth < old.depth && entry.bound != TTBound::EXACT && getGeneration(data) == currentGeneration){
+                return;     //The stored result is more valuable
+            }
+            target = &slot;
+            samePosition = true;
+            break;
+        }
+        int value = (data == 0) ? -1024 : unpackEntry(data).depth - 4 * static_cast<uint8_t>(currentGeneration - getGeneration(data));
+        if (value < targetValue){
+            targetValue = value;
+            target = &slot;
+        }
+    }
+    assert(target != nullptr);
+
+    if (!samePosition && target->data.load(std::memory_order_relaxed) != 0){
+        TT_COUNT(overwriteCount);
+    }
+    uint64_t data = packEntry(entry, currentGeneration);
+    target->keyXorData.store(hash ^ data, std::memory_order_relaxed);
+    target->data.store(data, std::memory_order_relaxed);
+}
+
+
+size_t TranspositionTable::getEntryCount() const{
+    return static_cast<size_t>(bucketMask + 1) * TT_BUCKET_SIZE;
+}
+
+TTStatistics TranspositionTable::getStatistics() const{
+    TTStatistics statistics;
+    statistics.probes = probeCount.load(std::memory_order_relaxed);
+    statistics.hits = hitCount.load(std::memory_order_relaxed);
+    statistics.collisions = collisionCount.load(std::memory_order_relaxed);
+    statistics.stores = storeCount.load(std::memory_order_relaxed);
+    statistics.overwrites = overwriteCount.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+void TranspositionTable::resetStatistics(){
+    probeCount.store(0, std::memory_order_relaxed);
+    hitCount.store(0, std::memory_order_relaxed);
+    collisionCount.store(0, std::memory_order_relaxed);
+    storeCount.store(0, std::memory_order_relaxed);
+    overwriteCount.store(0, std::memory_order_relaxed);
+}
+
+void TranspositionTable::printStatistics(std::ostream& output) const{
+    //The fill rate is estimated from the first buckets
+    const uint64_t sampleBuckets = (bucketMask + 1 < 1024) ? bucketMask + 1 : 1024;
+    uint64_t used = 0;
+    for (uint64_t b = 0; b < sampleBuckets; ++b){
+        for (unsigned int s = 0; s < TT_BUCKET_SIZE; ++s){
+            used += (buckets[b].slots[s].data.load(std::memory_order_relaxed) != 0) ? 1 : 0;
+        }
+    }
+
+    TTStatistics statistics = getStatistics();
+    const double probes = statistics.probes > 0 ? static_cast<double>(statistics.probes) : 1.;
+    const double stores = statistics.stores > 0 ? static_cast<double>(statistics.stores) : 1.;
+    output << std::fixed << std::setprecision(1)
+        << "entries: " << getEntryCount() << " (" << getEntryCount() * 16 / (1024 * 1024) << " MB), filled: " << 100. * used / (sampleBuckets * TT_BUCKET_SIZE) << "%" << std::endl
+        << "probes: " << statistics.probes << ", hits: " << 100. * statistics.hits / probes << "%, collisions: " << 100. * statistics.collisions / probes << "%" << std::endl
+        << "stores: " << statistics.stores << ", overwrites: " << 100. * statistics.overwrites / stores << "%" << std::endl;
+#if !TT_STATISTICS
+    output << "(the counters are disabled, see TT_STATISTICS)" << std::endl;
+#endif
+}
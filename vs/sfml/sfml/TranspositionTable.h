@@ -0,0 +1,83 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <ostream>
+
+
+//Hash table for searching AIs, which stores the results of already searched positions (keyed by the Zobrist-hash, see Position::getHash())
+//The table can be shared by several search threads without any locks:
+//  each entry consists of 2 words (key XOR data, data); a reader only accepts an entry, if (key XOR data) XOR data gives its key back
+//  --> an entry, which has been torn by 2 threads writing at the same time, is simply not found
+//A bucket of 4 entries fills exactly one cache line; a position can only be stored in the bucket selected by the lower bits of its hash
+
+
+#define TT_BUCKET_SIZE 4                //Entries per bucket
+#define TT_CACHE_LINE_SIZE 64           //Bytes; the buckets are aligned to cache lines
+#define TT_STATISTICS 1                 //1: count hits, collisions and overwrites (the counters are shared by all threads, this costs some performance)
+
+
+struct TTBound{
+    enum Enum{
+        NONE = 0,           //empty entry
+        EXACT = 1,          //score is the exact score of the position
+        LOWER = 2,          //score is a lower bound (the search failed high)
+        UPPER = 3           //score is an upper bound (the search failed low)
+    };
+};
+
+struct TTEntry{             //Content of an entry
+    int16_t score;
+    uint8_t depth;          //Remaining search depth, with which the score has been calculated
+    uint8_t bound;          //TTBound::Enum
+    uint8_t field;          //Best move: field for the meepleToSet (NO_FIELD, if there is none)
+    uint8_t give;           //Best move: meeple for the opponent (NO_MEEPLE, if there is none)
+};
+
+struct TTStatistics{
+    uint64_t probes;        //Number of calls of probe()
+    uint64_t hits;          //Probes, which found the position
+    uint64_t collisions;    //Probes, which didn't find the position in a full bucket (the position has been replaced, or never fit into the bucket)
+    uint64_t stores;        //Number of calls of store()
+    uint64_t overwrites;    //Stores, which replaced the entry of another position
+};
+
+
+class TranspositionTable{
+private:
+    struct Slot{
+        std::atomic<uint64_t> keyXorData;
+        std::atomic<uint64_t> data;
+    };
+    struct Bucket{
+        Slot slots[TT_BUCKET_SIZE];
+    };
+
+    unsigned char* memory;                  //The allocated memory (the buckets start at the first cache line within it)
+    Bucket* buckets;
+    uint64_t bucketMask;                    //Number of buckets - 1 (the number of buckets is a power of 2)
+    std::atomic<uint8_t> generation;        //Incremented with each new search; entries of older searches are replaced first
+
+    std::atomic<uint64_t> probeCount;
+    std::atomic<uint64_t> hitCount;
+    std::atomic<uint64_t> collisionCount;
+    std::atomic<uint64_t> storeCount;
+    std::atomic<uint64_t> overwriteCount;
+
+    TranspositionTable(const TranspositionTable&);
+    TranspositionTable& operator = (const TranspositionTable&);
+public:
+    explicit TranspositionTable(size_t megaBytes);      //The size is rounded down to a power of 2 (at least 1 bucket)
+    ~TranspositionTable();
+
+    void clear();                                       //Removes all entries; must not be called while other threads use the table
+    void newSearch();                                   //Marks all entries as old (they are kept, but are replaced first)
+
+    bool probe(uint64_t hash, TTEntry& entry);          //Returns true and fills the entry, if the position is in the table
+    void store(uint64_t hash, const TTEntry& entry);    //Stores the entry (if it isn't less valuable than all entries of the bucket)
+
+    size_t getEntryCount() const;                       //Capacity of the table
+    TTStatistics getStatistics() const;
+    void resetStatistics();
+    void printStatistics(std::ostream& output) const;   //Prints the counters and the fill rate
+};
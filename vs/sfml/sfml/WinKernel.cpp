@@ -0,0 +1,180 @@
+#include "WinKernel.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include "Board.h"
+#include "Position.h"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+    #define WIN_KERNEL_X86 1
+    #include <immintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+        #define WIN_KERNEL_TARGET_AVX2                                  //MSVC allows AVX2-intrinsics in every function
+    #else
+        #define WIN_KERNEL_TARGET_AVX2 __attribute__((target("avx2")))  //gcc/clang: only this function is compiled for AVX2
+    #endif
+#else
+    #define WIN_KERNEL_X86 0
+#endif
+
+
+static_assert(sizeof(PackedBoard) == 16, "A PackedBoard has to fit into a SSE-register");
+
+
+PackedBoard PackedBoard::fromBoard(const Board& board){
+    PackedBoard packed;
+    for (uint8_t p = 0; p < PROPERTY_PLANE_COUNT; ++p){
+        packed.planes[p] = board.getPropertyPlane(p);
+    }
+    return packed;
+}
+
+PackedBoard PackedBoard::fromPosition(const Position& position){
+    PackedBoard packed = { { 0, 0, 0, 0, 0, 0, 0, 0 } };
+    for (uint16_t fields = position.occupied; fields != 0; fields &= fields - 1){
+        uint8_t field = lowestBitIndex(fields);
+        uint8_t code = position.getMeepleCode(field);
+        for (uint8_t p = 0; p < PROPERTY_COUNT; ++p){
+            packed.planes[getPropertyPlaneIndex(p, (code >> p) & 1)] |= static_cast<uint16_t>(1 << field);
+        }
+    }
+    return packed;
+}
+
+
+
+const char* WinKernel::toString(Enum kernel){
+    switch (kernel){
+        case SCALAR:    return "scalar";
+        case SSE2:      return "SSE2";
+        case AVX2:      return "AVX2";
+        default: assert(false); return "";
+    }
+}
+
+bool WinKernel::isSupported(Enum kernel){
+    if (kernel == SCALAR){
+        return true;
+    }
+#if WIN_KERNEL_X86
+    #ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        int maxLeaf = info[0];
+        __cpuid(info, 1);
+        if (kernel == SSE2){
+            return (info[3] & (1 << 26)) != 0;
+        }
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        if (maxLeaf < 7 || !osxsave || !avx || (_xgetbv(0) & 6) != 6){     //the OS has to save the YMM-registers
+            return false;
+        }
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+    #else
+        __builtin_cpu_init();
+        return (kernel == SSE2) ? __builtin_cpu_supports("sse2") != 0 : __builtin_cpu_supports("avx2") != 0;
+    #endif
+#else
+    return false;
+#endif
+}
+
+WinKernel::Enum WinKernel::getBest(){
+    if (isSupported(AVX2)){
+        return AVX2;
+    }
+    if (isSupported(SSE2)){
+        return SSE2;
+    }
+    return SCALAR;
+}
+
+
+
+static void checkWinLinesScalar(const PackedBoard* boards, uint16_t* wonLines, size_t count){     //SWAR: 4 planes per 64 bit word
+    const uint64_t LANE_ONES = 0x0001000100010001ULL;
+    const uint64_t LANE_HIGH_BITS = 0x8000800080008000ULL;
+    for (size_t b = 0; b < count; ++b){
+        uint64_t planes[2];
+        memcpy(planes, boards[b].planes, sizeof(planes));
+        uint16_t won = 0;
+        for (uint8_t line = 0; line < WIN_LINE_COUNT; ++line){
+            uint64_t mask = WIN_LINE_MASKS[line] * LANE_ONES;
+            uint64_t missing0 = (planes[0] & mask) ^ mask;      //a lane is 0, if the whole line is in the plane (4 meeples with the same property-value)
+            uint64_t missing1 = (planes[1] & mask) ^ mask;
+            uint64_t zeroLanes = ((missing0 - LANE_ONES) & ~missing0) | ((missing1 - LANE_ONES) & ~missing1);
+            won |= static_cast<uint16_t>(((zeroLanes & LANE_HIGH_BITS) != 0) << line);
+        }
+        wonLines[b] = won;
+    }
+}
+
+
+#if WIN_KERNEL_X86
+
+static void checkWinLinesSSE2(const PackedBoard* boards, uint16_t* wonLines, size_t count){
+    __m128i masks[WIN_LINE_COUNT];
+    for (uint8_t line = 0; line < WIN_LINE_COUNT; ++line){
+        masks[line] = _mm_set1_epi16(static_cast<short>(WIN_LINE_MASKS[line]));
+    }
+    for (size_t b = 0; b < count; ++b){
+        __m128i planes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&boards[b]));     //all 8 planes of the board
+        unsigned int won = 0;
+        for (uint8_t line = 0; line < WIN_LINE_COUNT; ++line){
+            __m128i full = _mm_cmpeq_epi16(_mm_and_si128(planes, masks[line]), masks[line]);
+            won |= static_cast<unsigned int>(_mm_movemask_epi8(full) != 0) << line;
+        }
+        wonLines[b] = static_cast<uint16_t>(won);
+    }
+}
+
+WIN_KERNEL_TARGET_AVX2
+static void checkWinLinesAVX2(const PackedBoard* boards, uint16_t* wonLines, size_t count){
+    __m256i masks[WIN_LINE_COUNT];
+    for (uint8_t line = 0; line < WIN_LINE_COUNT; ++line){
+        masks[line] = _mm256_set1_epi16(static_cast<short>(WIN_LINE_MASKS[line]));
+    }
+    size_t b = 0;
+    for (; b + 4 <= count; b += 4){             //2 registers with 2 boards each (independent --> better pipelining)
+        __m256i planes01 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&boards[b]));
+        __m256i planes23 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&boards[b + 2]));
+        unsigned int won0 = 0, won1 = 0, won2 = 0, won3 = 0;
+        for (uint8_t line = 0; line < WIN_LINE_COUNT; ++line){
+            unsigned int full01 = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_and_si256(planes01, masks[line]), masks[line])));
+            unsigned int full23 = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_and_si256(planes23, masks[line]), masks[line])));
+            won0 |= static_cast<unsigned int>((full01 & 0xFFFF) != 0) << line;     //lower 16 bytes = first board
+            won1 |= static_cast<unsigned int>((full01 >> 16) != 0) << line;
+            won2 |= static_cast<unsigned int>((full23 & 0xFFFF) != 0) << line;
+            won3 |= static_cast<unsigned int>((full23 >> 16) != 0) << line;
+        }
+        wonLines[b] = static_cast<uint16_t>(won0);
+        wonLines[b + 1] = static_cast<uint16_t>(won1);
+        wonLines[b + 2] = static_cast<uint16_t>(won2);
+        wonLines[b + 3] = static_cast<uint16_t>(won3);
+    }
+    checkWinLinesSSE2(boards + b, wonLines + b, count - b);    //remaining 0-3 boards
+}
+
+#endif
+
+
+void checkWinLines(const PackedBoard* boards, uint16_t* wonLines, size_t count, WinKernel::Enum kernel){
+    assert(WinKernel::isSupported(kernel));
+    switch (kernel){
+#if WIN_KERNEL_X86
+        case WinKernel::AVX2:   checkWinLinesAVX2(boards, wonLines, count); break;
+        case WinKernel::SSE2:   checkWinLinesSSE2(boards, wonLines, count); break;
+#endif
+        default:                checkWinLinesScalar(boards, wonLines, count); break;
+    }
+}
+
+static const WinKernel::Enum BEST_WIN_KERNEL = WinKernel::getBest();     //The CPU doesn't change - detect it once at startup
+
+void checkWinLines(const PackedBoard* boards, uint16_t* wonLines, size_t count){
+    checkWinLines(boards, wonLines, count, BEST_WIN_KERNEL);
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+#include "Bitboard.h"
+
+class Board;
+struct Position;
+
+
+//Batch win detection: checks many boards at once (e.g. for playouts and simulations)
+//The result for each board is the same as Board::checkWinSituation() computes: bit l of the mask is set, if the line WIN_LINE_MASKS[l] contains 4 similar meeples
+
+
+//A board, packed into 16 bytes: the property planes of Board::getPropertyPlane()
+//(the occupied fields are the union of both planes of any property, so they don't need to be stored)
+struct PackedBoard{
+    uint16_t planes[PROPERTY_PLANE_COUNT];
+
+    static PackedBoard fromBoard(const Board& board);
+    static PackedBoard fromPosition(const Position& position);
+};
+
+
+struct WinKernel{
+    enum Enum{
+        SCALAR,             //portable C++
+        SSE2,               //1 board (8 planes) per instruction
+        AVX2                //2 boards (16 planes) per instruction
+    };
+    static const char* toString(Enum kernel);
+    static bool isSupported(Enum kernel);   //Checks the CPU (and the OS support for the registers) at runtime
+    static Enum getBest();                  //Fastest kernel, that is supported by this CPU
+};
+
+
+void checkWinLines(const PackedBoard* boards, uint16_t* wonLines, size_t count);                          //Writes the won lines of each board to wonLines (uses the best kernel)
+void checkWinLines(const PackedBoard* boards, uint16_t* wonLines, size_t count, WinKernel::Enum kernel);  //Uses the given kernel; the kernel must be supported (for tests and benchmarks)
@@ -0,0 +1,30 @@
+#include "Zobrist.h"
+
+
+static uint64_t nextZobristKey(uint64_t& state){     //splitmix64 (deterministic, and good enough to fill the tables)
+    state += 0x9E3779B97F4A7C15ULL;
+    uint64_t z = state;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+
+ZobristKeys::ZobristKeys(){
+    uint64_t state = 0x4D65657071653421ULL;     //fixed seed
+    for (uint8_t f = 0; f < FIELD_COUNT; ++f){
+        for (uint8_t code = 0; code < 16; ++code){
+            field[f][code] = nextZobristKey(state);
+        }
+    }
+    for (uint8_t code = 0; code < 16; ++code){
+        inBag[code] = nextZobristKey(state);
+    }
+    for (uint8_t code = 0; code < 16; ++code){
+        meepleToSet[code] = nextZobristKey(state);
+    }
+    blackToMove = nextZobristKey(state);
+}
+
+
+const ZobristKeys ZOBRIST;
@@ -0,0 +1,19 @@
+#pragma once
+#include <cstdint>
+
+#include "Bitboard.h"
+
+
+//Random keys for the Zobrist-hashing of positions
+//The hash of a position is the XOR of the keys of all its parts - so it can be updated incrementally, whenever a meeple is set, removed, or taken from a bag
+//The keys are generated with a fixed seed: the hashes are the same in every run (and on every machine)
+struct ZobristKeys{
+    uint64_t field[FIELD_COUNT][16];    //[field][meeple code]: meeple is on the field
+    uint64_t inBag[16];                 //[meeple code]: meeple is in a bag
+    uint64_t meepleToSet[16];           //[meeple code]: meeple has been chosen, and has to be set next
+    uint64_t blackToMove;               //The black player has to act next
+
+    ZobristKeys();
+};
+
+extern const ZobristKeys ZOBRIST;
@@ -19,6 +19,8 @@ extern const unsigned int MAX_PARTICLE_COUNT;   //Max. number of particles per p
 #define THREAD_DEBUGGING 0                  //prints messages regarding multithreading within the main thread
 #define THREAD_DEBUG_MESSAGES 0             //prints messages within other threads; might destroy the output due to concurrency (no flush is used)
 
+#define SMART_AI_CHECK_TABLES 0             //compares the table-based points of the SmartAI with the original calculation (assert); slow
+
 
 #ifdef PRINT_ALL
     #define PRINT_BOARD_TO_CONSOLE 1        
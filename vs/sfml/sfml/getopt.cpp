@@ -8,6 +8,13 @@
 #include <stdint.h>
 
 #include "GameSettings.h"
+#include "Benchmark.h"
+#include "Perft.h"
+#include "Bitboard.h"
+#include "SolverAI.h"
+#include "Tablebase.h"
+#include "OpeningBook.h"
+#include "HeuristicParameters.h"
 
 
 
@@ -40,12 +47,29 @@ void print_usage(char *programName){            //Prints Information on how to u
     std::cout << "      [-f]               Fast. The AI doesn't perform a sleep before it's tasks." << std::endl;
     std::cout << "      [-i]               Immediate. The AI's meeples are not slowly moved to the board. They will be positioned immediately." << std::endl;
     std::cout << "      [-m]               Muted. The game will run silent and will not produce any sound." << std::endl;
+    std::cout << "      [-depth=turns]     Searching AIs search exactly this number of turns (reproducible results)." << std::endl;
+    std::cout << "      [-movetime=sec]    Searching AIs search until the time is up (iterative deepening)." << std::endl;
+    std::cout << "      [-playouts=number] Monte Carlo AIs play exactly this number of playouts per decision (reproducible results)." << std::endl;
+    std::cout << "      [-threads=number]  Number of threads of searching AIs (default: all cores but one; the simulator uses 1 thread)." << std::endl;
+    std::cout << "      [-bench=suite]     Runs a benchmark instead of the game." << std::endl;
+    std::cout << "                         Possible suites:" << std::endl;
+    printBenchmarkSuites(std::cout);
+    std::cout << "      [-perft=depth]     Counts the positions, wins and ties of the game tree up to depth moves (1-" << MAX_PERFT_DEPTH << ") instead of running the game." << std::endl;
+    std::cout << "      [-position=\"text\"] Start position for -perft=, e.g. \"5...........a... w 2\": 16 fields ('.' or meeple code 0-f), side to move (w/b), meeple to set (0-f or -)." << std::endl;
+    std::cout << "      [-gentb=fields]    Generates the endgame tablebase " << TABLEBASE_FILE << " for positions with up to this number of empty fields (1-" << TABLEBASE_MAX_EMPTY_FIELDS << ")." << std::endl;
+    std::cout << "      [-tbgames=number]  Number of sampled games for -gentb= (default: " << TABLEBASE_DEFAULT_GAMES << ")." << std::endl;
+    std::cout << "      [-genbook=plies]   Generates the opening book " << OPENING_BOOK_FILE << " for all positions of the first plies (1-" << OPENING_BOOK_MAX_PLIES << ")." << std::endl;
+    std::cout << "      [-bookplayouts=number] Playouts per position for -genbook= (default: " << OPENING_BOOK_DEFAULT_PLAYOUTS << ")." << std::endl;
+    std::cout << "      [-tune=iterations] Tunes the weights of the AI of player 1 (thinking or smart) by self-play, and writes them to " << HEURISTIC_PARAMETERS_FILE << "." << std::endl;
+    std::cout << "      [-tunegames=number] Self-play games per iteration for -tune= (default: " << HEURISTIC_TUNING_DEFAULT_GAMES << ")." << std::endl;
     std::cout << "      -p1=palyerName" << std::endl;
     std::cout << "      -p2=playerName     Defines the players which are playing against each other." << std::endl;
     std::cout << "                         Possible players:    stupid" << std::endl;
     std::cout << "                                              random" << std::endl;
     std::cout << "                                              thinking" << std::endl;
     std::cout << "                                              smart" << std::endl;
+    std::cout << "                                              solver" << std::endl;
+    std::cout << "                                              mcts" << std::endl;
 }
 
 
@@ -87,6 +111,125 @@ GameSettings* parseConsoleParameters(int argc, char *argv[]){   //creates a sett
             continue;
         }
 
+        if (strcmpci(argv[i], "-perft=", 7)){
+            long depth = strtol(argv[i] + 7, nullptr, 10);
+            if (depth < 1 || depth > MAX_PERFT_DEPTH){
+                std::cout << "Option \"-perft=\" has an invalid value. The content needs to be an integer between 1 and " << MAX_PERFT_DEPTH << "." << std::endl;
+                delete settings;
+                return nullptr;
+            }
+            settings->perftDepth = static_cast<unsigned int>(depth);
+            continue;
+        }
+        if (strcmpci(argv[i], "-position=", 10)){
+            settings->perftPosition = argv[i] + 10;
+            continue;
+        }
+        if (strcmpci(argv[i], "-gentb=", 7)){
+            long emptyFields = strtol(argv[i] + 7, nullptr, 10);
+            if (emptyFields < 1 || emptyFields > TABLEBASE_MAX_EMPTY_FIELDS){
+                std::cout << "Option \"-gentb=\" has an invalid value. The content needs to be an integer between 1 and " << TABLEBASE_MAX_EMPTY_FIELDS << "." << std::endl;
+                delete settings;
+                return nullptr;
+            }
+            settings->tablebaseEmptyFields = static_cast<unsigned int>(emptyFields);
+            continue;
+        }
+        if (strcmpci(argv[i], "-tbgames=", 9)){
+            long games = strtol(argv[i] + 9, nullptr, 10);
+            if (games < 1 || games > 10000000){
+                std::cout << "Option \"-tbgames=\" has an invalid value. The content needs to be an integer between 1 and 10000000." << std::endl;
+                delete settings;
+                return nullptr;
+            }
+            settings->tablebaseGames = static_cast<unsigned int>(games);
+            continue;
+        }
+        if (strcmpci(argv[i], "-genbook=", 9)){
+            long plies = strtol(argv[i] + 9, nullptr, 10);
+            if (plies < 1 || plies > OPENING_BOOK_MAX_PLIES){
+                std::cout << "Option \"-genbook=\" has an invalid value. The content needs to be an integer between 1 and " << OPENING_BOOK_MAX_PLIES << "." << std::endl;
+                delete settings;
+                return nullptr;
+            }
+            settings->openingBookPlies = static_cast<unsigned int>(plies);
+            continue;
+        }
+        if (strcmpci(argv[i], "-bookplayouts=", 14)){
+            long playouts = strtol(argv[i] + 14, nullptr, 10);
+            if (playouts < 1 || playouts > 100000000){
+                std::cout << "Option \"-bookplayouts=\" has an invalid value. The content needs to be an integer between 1 and 100000000." << std::endl;
+                delete settings;
+                return nullptr;
+            }
+            settings->openingBookPlayouts = static_cast<unsigned int>(playouts);
+            continue;
+        }
+        if (strcmpci(argv[i], "-tune=", 6)){
+            long iterations = strtol(argv[i] + 6, nullptr, 10);
+            if (iterations < 1 || iterations > 1000000){
+                std::cout << "Option \"-tune=\" has an invalid value. The content needs to be an integer between 1 and 1000000." << std::endl;
+                delete settings;
+                return nullptr;
+            }
+            settings->tuneIterations = static_cast<unsigned int>(iterations);
+            continue;
+        }
+        if (strcmpci(argv[i], "-tunegames=", 11)){
+            long games = strtol(argv[i] + 11, nullptr, 10);
+            if (games < 2 || games > 100000000){
+                std::cout << "Option \"-tunegames=\" has an invalid value. The content needs to be an integer between 2 and 100000000." << std::endl;
+                delete settings;
+                return nullptr;
+            }
+            settings->tuneGames = static_cast<unsigned int>(games);
+            continue;
+        }
+        if (strcmpci(argv[i], "-depth=", 7)){
+            long depth = strtol(argv[i] + 7, nullptr, 10);
+            if (depth < 1 || depth > FIELD_COUNT + 1){
+                std::cout << "Option \"-depth=\" has an invalid value. The content needs to be an integer between 1 and " << FIELD_COUNT + 1 << "." << std::endl;
+                delete settings;
+                return nullptr;
+            }
+            settings->searchLimits[0].depth = settings->searchLimits[1].depth = static_cast<unsigned int>(depth);
+            continue;
+        }
+        if (strcmpci(argv[i], "-threads=", 9)){
+            long threads = strtol(argv[i] + 9, nullptr, 10);
+            if (threads < 1 || threads > SOLVER_MAX_THREADS){
+                std::cout << "Option \"-threads=\" has an invalid value. The content needs to be an integer between 1 and " << SOLVER_MAX_THREADS << "." << std::endl;
+                delete settings;
+                return nullptr;
+            }
+            settings->searchThreads = static_cast<unsigned int>(threads);
+            continue;
+        }
+        if (strcmpci(argv[i], "-playouts=", 10)){
+            long playouts = strtol(argv[i] + 10, nullptr, 10);
+            if (playouts < 1 || playouts > 100000000){
+                std::cout << "Option \"-playouts=\" has an invalid value. The content needs to be an integer between 1 and 100000000." << std::endl;
+                delete settings;
+                return nullptr;
+            }
+            settings->searchLimits[0].playouts = settings->searchLimits[1].playouts = static_cast<unsigned int>(playouts);
+            continue;
+        }
+        if (strcmpci(argv[i], "-movetime=", 10)){
+            double moveTime = strtod(argv[i] + 10, nullptr);
+            if (moveTime <= 0 || moveTime > 3600){
+                std::cout << "Option \"-movetime=\" has an invalid value. The content needs to be a number of seconds between 0 and 3600." << std::endl;
+                delete settings;
+                return nullptr;
+            }
+            settings->searchLimits[0].moveTime = settings->searchLimits[1].moveTime = static_cast<float>(moveTime);
+            continue;
+        }
+        if (strcmpci(argv[i], "-bench=", 7)){
+            settings->benchmark = argv[i] + 7;
+            continue;
+        }
+
         interpreted = false;
         for (uint8_t pNr = 0; pNr < 2; ++pNr){        //Check if the AI is given
             optStr[2] = pNr + '1';
@@ -105,6 +248,12 @@ GameSettings* parseConsoleParameters(int argc, char *argv[]){   //creates a sett
                 }
                 else if (strcmpci(player_cstr, "smart")){
                     settings->playerType[pNr] = GameSettings::SMART_AI;
+                }
+                else if (strcmpci(player_cstr, "solver")){
+                    settings->playerType[pNr] = GameSettings::SOLVER_AI;
+                }
+                else if (strcmpci(player_cstr, "mcts")){
+                    settings->playerType[pNr] = GameSettings::MCTS_AI;
                 }else{
                     std::cout << "Option " << optStr << " has an invalid value: unknown AI \"" << player_cstr << "\"" << std::endl;
                     delete settings; 
@@ -122,6 +271,16 @@ GameSettings* parseConsoleParameters(int argc, char *argv[]){   //creates a sett
         return nullptr;
     }
 
+    if (!settings->benchmark.empty() || settings->perftDepth > 0 || settings->tablebaseEmptyFields > 0 || settings->openingBookPlies > 0){
+        return settings;    //The players aren't needed
+    }
+
+    if (settings->tuneIterations > 0 && settings->playerType[0] != GameSettings::THINKING_AI && settings->playerType[0] != GameSettings::SMART_AI){
+        std::cout << "Incompatible settings. Only the parameters of the thinking and the smart AI can be tuned (set -p1=thinking or -p1=smart)." << std::endl;
+        delete settings;
+        return nullptr;
+    }
+
     if (settings->simulator > 0 && (settings->playerType[0] == GameSettings::HUMAN || settings->playerType[1] == GameSettings::HUMAN)){
         std::cout << "Incompatible settings. Set player 1 and 2 to something different than a Human. Humans can't be simulated." << std::endl;
         delete settings;
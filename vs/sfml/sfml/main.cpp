@@ -24,6 +24,11 @@
 #include "GameSettings.h"
 #include "getopt.h"
 #include "Tutorial.h"
+#include "Benchmark.h"
+#include "Perft.h"
+#include "Tablebase.h"
+#include "OpeningBook.h"
+#include "HeuristicParameters.h"
 
 #define PI 3.14159265
 #include "ThreadedGameSimulator.h"
@@ -138,6 +143,40 @@ int main(int argc, char *argv[]){
             soundManager.setEffectsVolume(0);
         }
     }
+    if (settings != nullptr && !settings->benchmark.empty()){
+        if (!runBenchmark(settings->benchmark)){
+            std::cout << "Unknown benchmark suite \"" << settings->benchmark << "\"" << std::endl;
+            print_usage(argv[0]);
+        }
+        std::cin.ignore();   //wait for keypress
+        exit(0);
+    }
+    if (settings != nullptr && settings->perftDepth > 0){
+        runPerft(settings->perftDepth, settings->perftPosition);
+        std::cin.ignore();   //wait for keypress
+        exit(0);
+    }
+    if (settings != nullptr && settings->tablebaseEmptyFields > 0){
+        generateTablebase(settings->tablebaseEmptyFields, settings->tablebaseGames, TABLEBASE_FILE);
+        std::cin.ignore();   //wait for keypress
+        exit(0);
+    }
+    if (settings != nullptr && settings->openingBookPlies > 0){
+        generateOpeningBook(settings->openingBookPlies, settings->openingBookPlayouts, OPENING_BOOK_FILE);
+        std::cin.ignore();   //wait for keypress
+        exit(0);
+    }
+    HeuristicParameters::getGlobal().load(HEURISTIC_PARAMETERS_FILE);      //optional: without the file, the AIs use their original weights
+
+    if (settings != nullptr && settings->tuneIterations > 0){       //before the tablebase and the book are loaded: the tuning games have to be decided by the heuristic
+        tuneHeuristicParameters(settings->playerType[0] == GameSettings::SMART_AI, settings->tuneIterations, settings->tuneGames, HEURISTIC_PARAMETERS_FILE);
+        std::cin.ignore();   //wait for keypress
+        exit(0);
+    }
+
+    Tablebase::getGlobal().load(TABLEBASE_FILE);        //optional: without the files, the AIs search the endgame and the opening themselves
+    OpeningBook::getGlobal().load(OPENING_BOOK_FILE);
+
     if (settings != nullptr && settings->simulator > 0){
         AI_testFunction(*settings);
         exit(0);
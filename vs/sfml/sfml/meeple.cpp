@@ -21,6 +21,16 @@ std::string MeepleDetail::toString(Enum detail){
 }
 
 
+unsigned int MeepleProperty::getValue() const{
+    switch (type){
+        case MEEPLE_COLOR:	return value.color;
+        case MEEPLE_SIZE:	return value.size;
+        case MEEPLE_SHAPE:	return value.shape;
+        case MEEPLE_DETAIL:	return value.detail;
+        default: assert(false); return 0;
+    }
+}
+
 bool MeepleProperty::operator == (const MeepleProperty& prop){
     assert(type == prop.type);
     switch (type){
@@ -42,10 +52,20 @@ bool MeepleProperty::operator != (const MeepleProperty& prop){
 
 Meeple::Meeple(MeepleColor::Enum color, MeepleSize::Enum size, MeepleShape::Enum shape, MeepleDetail::Enum detail) :
     color(color), size(size), shape(shape), detail(detail){
+    code = static_cast<uint8_t>(color | (size << 1) | (shape << 2) | (detail << 3));
+}
+
+Meeple::Meeple(uint8_t code) :
+    color(static_cast<MeepleColor::Enum>(code & 1)),
+    size(static_cast<MeepleSize::Enum>((code >> 1) & 1)),
+    shape(static_cast<MeepleShape::Enum>((code >> 2) & 1)),
+    detail(static_cast<MeepleDetail::Enum>((code >> 3) & 1)),
+    code(code & 0xF){
+    assert(code < 16);
 }
 
 Meeple::Meeple(const Meeple& base) :
-    color(base.color), size(base.size), shape(base.shape), detail(base.detail){
+    color(base.color), size(base.size), shape(base.shape), detail(base.detail), code(base.code){
 }
 
 MeepleProperty Meeple::getProperty(MeepleProperty::Type type) const{
@@ -105,6 +125,10 @@ MeepleDetail::Enum Meeple::getDetail() const{
     return detail;
 }
 
+uint8_t Meeple::getCode() const{
+    return code;
+}
+
 bool Meeple::hasSameProperty(MeepleProperty prop) const{
     switch (prop.type){
         case MeepleProperty::MEEPLE_COLOR:  return color == prop.value.color;
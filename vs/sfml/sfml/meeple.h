@@ -1,6 +1,7 @@
 #pragma once
 
 #include "helper.h"
+#include <cstdint>
 #include <ostream>
 #include <assert.h>
 
@@ -52,6 +53,8 @@ struct MeepleProperty{
         MeepleDetail::Enum detail;
     } value;
     
+    unsigned int getValue() const;      //Returns the enum-value of the property (0 or 1), independent of the type
+
     bool operator == (const MeepleProperty& prop);
     bool operator != (const MeepleProperty& prop);
 };
@@ -66,15 +69,18 @@ private:
     MeepleSize::Enum size;
     MeepleShape::Enum shape;
     MeepleDetail::Enum detail;
+    uint8_t code;                       //All 4 properties in one number (see getCode())
 
 public:
     Meeple(MeepleColor::Enum color, MeepleSize::Enum size, MeepleShape::Enum shape, MeepleDetail::Enum detail);
+    explicit Meeple(uint8_t code);                              //Creates a meeple with the properties of the code (see getCode())
     explicit Meeple(const Meeple& base);
    
     MeepleColor::Enum getColor() const;
     MeepleSize::Enum getSize() const;
     MeepleShape::Enum getShape() const;
     MeepleDetail::Enum getDetail() const;
+    uint8_t getCode() const;                                                //Returns the 4 properties as a 4 bit number: bit 0 = color, 1 = size, 2 = shape, 3 = detail (bit set = 2nd enum value)
 
     MeepleProperty getProperty(MeepleProperty::Type type) const;   
     MeepleProperty::Type getPropertyType(unsigned int propIdx) const;       //Returns the type, which is represented by this index